@@ -0,0 +1,309 @@
+//-----------------------------------------------------------------------------
+// src/engine/assets/asset_manager.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <glad/gl.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+module Engine.Assets.AssetManager;
+
+//-----------------------------------------------------------------------------
+// Module-level constants
+//-----------------------------------------------------------------------------
+// Rows are uploaded in slices of about this many bytes, so one huge atlas
+// cannot stall a frame for its whole transfer.
+static constexpr size_t UPLOAD_SLICE_BYTES = 1U << 20U;
+
+//-----------------------------------------------------------------------------
+// TextureHandle
+//-----------------------------------------------------------------------------
+TextureHandle::TextureHandle(AssetManager* owner, const uint32_t slot)
+    : owner_(owner), slot_(slot) {
+    owner_->add_ref(slot_);
+}
+
+TextureHandle::TextureHandle(const TextureHandle& other)
+    : owner_(other.owner_), slot_(other.slot_) {
+    if (owner_ != nullptr) {
+        owner_->add_ref(slot_);
+    }
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept
+    : owner_(other.owner_), slot_(other.slot_) {
+    other.owner_ = nullptr;
+}
+
+auto TextureHandle::operator=(const TextureHandle& other) -> TextureHandle& {
+    if (this != &other) {
+        if (other.owner_ != nullptr) {
+            other.owner_->add_ref(other.slot_);
+        }
+        reset();
+        owner_ = other.owner_;
+        slot_  = other.slot_;
+    }
+    return *this;
+}
+
+auto TextureHandle::operator=(TextureHandle&& other) noexcept
+        -> TextureHandle& {
+    if (this != &other) {
+        reset();
+        owner_       = other.owner_;
+        slot_        = other.slot_;
+        other.owner_ = nullptr;
+    }
+    return *this;
+}
+
+TextureHandle::~TextureHandle() {
+    reset();
+}
+
+void TextureHandle::reset() {
+    if (owner_ != nullptr) {
+        owner_->release(slot_);
+        owner_ = nullptr;
+    }
+}
+
+auto TextureHandle::valid() const -> bool {
+    return owner_ != nullptr;
+}
+
+auto TextureHandle::state() const -> AssetState {
+    return owner_ == nullptr ? AssetState::Failed
+                             : owner_->slots_[slot_].state;
+}
+
+auto TextureHandle::texture() const -> const TextureInfo* {
+    if (owner_ == nullptr) {
+        return nullptr;
+    }
+    const auto& slot = owner_->slots_[slot_];
+    return slot.state == AssetState::Ready ? &slot.info : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// AssetManager: lifetime
+//-----------------------------------------------------------------------------
+AssetManager::AssetManager(ThreadPool& pool) : pool_(pool) {}
+
+AssetManager::~AssetManager() {
+    {
+        std::unique_lock lock(decoded_mutex_);
+        decodes_done_.wait(lock, [this] { return in_flight_ == 0; });
+    }
+    for (auto& slot : slots_) {
+        assert(slot.refs == 0 && "TextureHandle outlived its AssetManager");
+        if (slot.info.id != 0U) {
+            glDeleteTextures(1, &slot.info.id);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// AssetManager: loading
+//-----------------------------------------------------------------------------
+auto AssetManager::load_texture(const std::string& path) -> TextureHandle {
+    if (const auto iter = by_path_.find(path); iter != by_path_.end()) {
+        return {this, iter->second};
+    }
+
+    uint32_t slot_idx = 0;
+    if (!free_slots_.empty()) {
+        slot_idx = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot_idx = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    auto& slot = slots_[slot_idx];
+    slot.path  = path;
+    slot.info  = {};
+    slot.state = AssetState::Loading;
+    by_path_.emplace(path, slot_idx);
+    ++stats_.textures;
+
+    {
+        const std::scoped_lock lock(decoded_mutex_);
+        ++in_flight_;
+    }
+    pool_.submit([this, slot_idx, generation = slot.generation, path] {
+        auto image = load_image(path);
+
+        // Notify under the lock: once it is released the destructor may run
+        const std::scoped_lock lock(decoded_mutex_);
+        decoded_.push_back({.slot = slot_idx,
+                .generation       = generation,
+                .image            = std::move(image)});
+        --in_flight_;
+        decodes_done_.notify_all();
+    });
+
+    return {this, slot_idx};
+}
+
+void AssetManager::add_ref(const uint32_t slot) {
+    ++slots_[slot].refs;
+}
+
+void AssetManager::release(const uint32_t slot_idx) {
+    auto& slot = slots_[slot_idx];
+    assert(slot.refs > 0);
+    if (--slot.refs != 0) {
+        return;
+    }
+
+    // Last handle gone. A decode or upload still in flight for this slot is
+    // dropped when it next shows up, because the generation no longer matches.
+    if (slot.info.id != 0U) {
+        glDeleteTextures(1, &slot.info.id);
+    }
+    forget_path(slot_idx);
+    slot.path.clear();
+    slot.info = {};
+    ++slot.generation;
+    free_slots_.push_back(slot_idx);
+    --stats_.textures;
+}
+
+void AssetManager::forget_path(const uint32_t slot_idx) {
+    // A failed slot may already have been replaced by a retry of its path
+    const auto iter = by_path_.find(slots_[slot_idx].path);
+    if (iter != by_path_.end() && iter->second == slot_idx) {
+        by_path_.erase(iter);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// AssetManager: per-frame upload
+//-----------------------------------------------------------------------------
+auto AssetManager::pump_uploads(const std::chrono::nanoseconds budget)
+        -> bool {
+    using Clock      = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    adopt_decoded();
+
+    while (!uploads_.empty()) {
+        auto& upload = uploads_.front();
+        if (slots_[upload.slot].generation != upload.generation) {
+            uploads_.pop_front(); // released while queued
+            continue;
+        }
+        if (upload_slice(upload)) {
+            slots_[upload.slot].state = AssetState::Ready;
+            uploads_.pop_front();
+        }
+        if (Clock::now() - start >= budget) {
+            break;
+        }
+    }
+
+    const auto elapsed_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - start)
+                    .count());
+    stats_.last_pump_ns = elapsed_ns;
+    stats_.max_pump_ns  = std::max(stats_.max_pump_ns, elapsed_ns);
+
+    const std::scoped_lock lock(decoded_mutex_);
+    return !uploads_.empty() || in_flight_ != 0 || !decoded_.empty();
+}
+
+void AssetManager::adopt_decoded() {
+    {
+        const std::scoped_lock lock(decoded_mutex_);
+        decoded_scratch_.swap(decoded_);
+    }
+    for (auto& [slot_idx, generation, image] : decoded_scratch_) {
+        auto& slot = slots_[slot_idx];
+        if (slot.generation != generation) {
+            continue; // released before the decode finished
+        }
+        if (!image) {
+            // Existing handles see the failure; the path itself is evicted
+            // so the next load_texture() decodes it again
+            slot.state = AssetState::Failed;
+            forget_path(slot_idx);
+            continue;
+        }
+        uploads_.push_back({.slot = slot_idx,
+                .generation       = generation,
+                .image            = std::move(*image)});
+    }
+    decoded_scratch_.clear();
+}
+
+auto AssetManager::upload_slice(PendingUpload& upload) -> bool {
+    auto&       info  = slots_[upload.slot].info;
+    const auto& image = upload.image;
+
+    if (info.id == 0U) {
+        // Allocate storage once; rows are streamed in below
+        info.width  = image.width;
+        info.height = image.height;
+        glGenTextures(1, &info.id);
+        glBindTexture(GL_TEXTURE_2D, info.id);
+        glTexImage2D(GL_TEXTURE_2D,
+                0,
+                static_cast<GLint>(image.format),
+                static_cast<GLsizei>(image.width),
+                static_cast<GLsizei>(image.height),
+                0,
+                image.format,
+                GL_UNSIGNED_BYTE,
+                nullptr);
+        // Glyph and tile atlases are sampled texel-exact
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, info.id);
+    }
+
+    const uint32_t slice_rows = std::max<uint32_t>(1,
+            static_cast<uint32_t>(UPLOAD_SLICE_BYTES / std::max<uint32_t>(1, image.pitch)));
+    const uint32_t row_count = std::min(slice_rows, image.height - upload.next_row);
+
+    // Surface rows may be padded; describe the layout instead of repacking.
+    // The loader guarantees a pitch that is a multiple of 4, so whole pixels
+    // per row (rounded down) plus 4-byte alignment reproduce it exactly, even
+    // for RGB rows whose padding is not a whole pixel.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH,
+            static_cast<GLint>(image.pitch / image.bytes_per_pixel));
+    glTexSubImage2D(GL_TEXTURE_2D,
+            0,
+            0,
+            static_cast<GLint>(upload.next_row),
+            static_cast<GLsizei>(image.width),
+            static_cast<GLsizei>(row_count),
+            image.format,
+            GL_UNSIGNED_BYTE,
+            image.rows(upload.next_row, row_count).data());
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    upload.next_row += row_count;
+    stats_.bytes_uploaded += static_cast<uint64_t>(image.pitch) * row_count;
+    return upload.next_row >= image.height;
+}
+
+auto AssetManager::stats() const -> AssetStats {
+    AssetStats stats      = stats_;
+    stats.uploads_pending = uploads_.size();
+    const std::scoped_lock lock(decoded_mutex_);
+    stats.decodes_in_flight = in_flight_;
+    return stats;
+}
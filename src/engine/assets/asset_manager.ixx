@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// src/engine/assets/asset_manager.ixx
+// Path-cached, reference-counted textures: decoded on worker threads,
+// uploaded to GL on the main thread a slice at a time
+//-----------------------------------------------------------------------------
+module;
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+export module Engine.Assets.AssetManager;
+
+import Engine.Jobs.ThreadPool;
+import Engine.Platform.Sdl; // ImageData, load_image
+
+export enum class AssetState : uint8_t {
+    Loading = 0, // queued, decoding, or partially uploaded
+    Ready   = 1,
+    Failed  = 2,
+};
+
+export struct TextureInfo {
+    uint32_t id{0}; // GL texture name
+    uint32_t width{0};
+    uint32_t height{0};
+};
+
+export struct AssetStats {
+    size_t   textures{0};          // live cache entries, any state
+    size_t   decodes_in_flight{0};
+    size_t   uploads_pending{0};
+    uint64_t bytes_uploaded{0};
+    uint64_t last_pump_ns{0};
+    uint64_t max_pump_ns{0};
+};
+
+export class AssetManager;
+
+// Shared reference to a cached texture. Copies share the texture; the GL
+// texture is freed when the last handle goes away. Handles are main-thread
+// only and must not outlive their AssetManager.
+export class TextureHandle {
+public:
+    TextureHandle() = default;
+    TextureHandle(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    auto operator=(const TextureHandle& other) -> TextureHandle&;
+    auto operator=(TextureHandle&& other) noexcept -> TextureHandle&;
+    ~TextureHandle();
+
+    [[nodiscard]] auto valid() const -> bool;
+    [[nodiscard]] auto state() const -> AssetState;
+
+    // GL texture once fully uploaded, nullptr before that (or on failure)
+    [[nodiscard]] auto texture() const -> const TextureInfo*;
+
+private:
+    friend class AssetManager;
+    TextureHandle(AssetManager* owner, uint32_t slot);
+    void reset();
+
+    AssetManager* owner_{nullptr};
+    uint32_t      slot_{0};
+};
+
+export class AssetManager {
+public:
+    explicit AssetManager(ThreadPool& pool);
+
+    // Waits for in-flight decodes, then deletes every GL texture. Needs the
+    // GL context that the textures were created on to still be current.
+    ~AssetManager();
+
+    // non-copyable, non-movable: handles and decode jobs point back here
+    AssetManager(const AssetManager&)                    = delete;
+    auto operator=(const AssetManager&) -> AssetManager& = delete;
+
+    // Returns immediately. A path already in the cache shares its texture;
+    // otherwise the file is decoded in the background. A decode failure shows
+    // up as AssetState::Failed on the handles; the path is then dropped from
+    // the cache, so loading it again retries.
+    auto load_texture(const std::string& path) -> TextureHandle;
+
+    // Call once per frame on the GL thread. Adopts finished decodes and
+    // uploads texture rows until `budget` is spent (always at least one
+    // slice, so progress is guaranteed). Returns true while work remains.
+    auto pump_uploads(std::chrono::nanoseconds budget) -> bool;
+
+    [[nodiscard]] auto stats() const -> AssetStats;
+
+private:
+    friend class TextureHandle;
+
+    struct TextureSlot {
+        std::string path;
+        TextureInfo info;
+        AssetState  state{AssetState::Loading};
+        uint32_t    refs{0};
+        uint32_t    generation{0}; // bumped on free; stale jobs compare it
+    };
+
+    struct DecodedImage {
+        uint32_t                 slot;
+        uint32_t                 generation;
+        std::optional<ImageData> image;
+    };
+
+    struct PendingUpload {
+        uint32_t  slot;
+        uint32_t  generation;
+        ImageData image;
+        uint32_t  next_row{0};
+    };
+
+    void add_ref(uint32_t slot);
+    void release(uint32_t slot);
+    void forget_path(uint32_t slot); // drop the cache entry if still ours
+    void adopt_decoded();
+    auto upload_slice(PendingUpload& upload) -> bool; // true when complete
+
+    ThreadPool& pool_;
+
+    // Main-thread state
+    std::vector<TextureSlot>                  slots_;
+    std::vector<uint32_t>                     free_slots_;
+    std::unordered_map<std::string, uint32_t> by_path_;
+    std::deque<PendingUpload>                 uploads_;
+    AssetStats                                stats_;
+
+    // Shared with decode jobs
+    mutable std::mutex        decoded_mutex_;
+    std::condition_variable   decodes_done_;
+    std::vector<DecodedImage> decoded_;
+    std::vector<DecodedImage> decoded_scratch_; // main thread, swapped in
+    size_t                    in_flight_{0};
+};
@@ -1,3 +1,4 @@
 export module Engine.Core;
 
-export import :Types;
\ No newline at end of file
+export import :Types;
+export import :Random;
\ No newline at end of file
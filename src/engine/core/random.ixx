@@ -0,0 +1,56 @@
+module;
+#include <cstdint>
+
+export module Engine.Core:Random;
+
+// SplitMix64 step: turns any 64-bit value (e.g. session seed + tick) into a
+// well-mixed seed. Also used on its own as a stable hash finalizer.
+export constexpr auto mix_seed(uint64_t value) -> uint64_t {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+// Small deterministic PRNG (PCG32). Identical sequences on every platform
+// and compiler, unlike the <random> distributions.
+export class Rng {
+public:
+    constexpr explicit Rng(const uint64_t seed = 0) {
+        reseed(seed);
+    }
+
+    constexpr void reseed(const uint64_t seed) {
+        state_     = 0;
+        increment_ = (mix_seed(seed) << 1U) | 1U;
+        next_u32();
+        state_ += mix_seed(seed ^ 0xDA3E39CB94B95BDBULL);
+        next_u32();
+    }
+
+    constexpr auto next_u32() -> uint32_t {
+        const uint64_t old_state = state_;
+        state_ = (old_state * 6364136223846793005ULL) + increment_;
+        const auto xorshifted =
+                static_cast<uint32_t>(((old_state >> 18U) ^ old_state) >> 27U);
+        const auto rotation = static_cast<uint32_t>(old_state >> 59U);
+        return (xorshifted >> rotation) | (xorshifted << ((32U - rotation) & 31U));
+    }
+
+    // Uniform value in [0, bound) without modulo bias
+    constexpr auto next_below(const uint32_t bound) -> uint32_t {
+        if (bound == 0) {
+            return 0;
+        }
+        const uint32_t threshold = (0U - bound) % bound;
+        while (true) {
+            if (const uint32_t value = next_u32(); value >= threshold) {
+                return value % bound;
+            }
+        }
+    }
+
+private:
+    uint64_t state_{0};
+    uint64_t increment_{1};
+};
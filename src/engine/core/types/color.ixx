@@ -1,3 +1,6 @@
+module;
+#include <cstdint>
+
 export module Engine.Core:Types;
 
 export struct Color {
@@ -6,3 +9,12 @@ export struct Color {
     float b;
     float a;
 };
+
+// Packed 8-bit RGB, for per-cell console colors
+export struct Rgb8 {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+
+    friend constexpr auto operator==(const Rgb8&, const Rgb8&) -> bool = default;
+};
\ No newline at end of file
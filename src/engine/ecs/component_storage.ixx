@@ -3,24 +3,200 @@
 // Type-erased, contiguous storage for components of a given type
 // ----------------------------------------------------------------------------
 module;
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <numeric>
+#include <optional>
+#include <source_location>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <utility>
 
-export module Engine.Ecs.ComponentStorage;
+export module Engine.Ecs.Registry:ComponentStorage;
 
 import Engine.Ecs.Entity;
 
-export struct IComponentStorage {
-    virtual ~IComponentStorage()       = default;
-    virtual void remove(Entity entity) = 0;
+// The only writer of component storages, see below
+export class Registry;
+
+// Memory and layout of one component type's storage
+export struct StorageStats {
+    std::string_view type_name;
+    size_t           count{0};        // live components
+    size_t           capacity{0};     // dense slots allocated
+    size_t           sparse_slots{0}; // highest entity index seen + 1
+    size_t           bytes{0};        // heap bytes held, dense + sparse
+    size_t           slack_bytes{0};  // held but unused, summed per array
+    float            sparse_fill{0};  // count / sparse_slots
+    float            disorder{0};     // dense neighbours out of entity order
+};
+
+// A component removed from `entity` (detached or destroyed) at `version`
+export struct StorageRemoval {
+    Entity   entity;
+    uint32_t version{0};
+};
+
+// Type-erased view the Registry uses for group packing and bulk upkeep.
+// Reads are public; the mutators are private to the Registry.
+export class IComponentStorage {
+public:
+    virtual ~IComponentStorage() = default;
+
+    [[nodiscard]] virtual auto stats() const -> StorageStats = 0;
+
+    // Dense-order access, used to keep owned groups packed and aligned
+    [[nodiscard]] virtual auto size() const -> size_t = 0;
+    [[nodiscard]] virtual auto dense_entities() const
+            -> std::span<const Entity> = 0;
+    [[nodiscard]] virtual auto dense_index(Entity entity) const
+            -> int32_t = 0;
+
+private:
+    friend class Registry;
+
+    // Remove the entity's component, logging the removal at `version`
+    virtual void remove(Entity entity, uint32_t version) = 0;
+
+    // Forget removals older than `oldest`; the log stays complete from there
+    virtual void trim_removals(uint32_t oldest) = 0;
+
+    // Stamp every component as changed at `version` and restart the removal
+    // log there, as adopt() does (see Registry::restore)
+    virtual void stamp_all(uint32_t version) = 0;
+
+    // Release unused capacity, including sparse slots past the last user
+    virtual void shrink_to_fit() = 0;
+
+    virtual void swap_dense(size_t lhs, size_t rhs) = 0;
+
+    // Reorder dense slots [first, last) by entity index, so storages iterate
+    // in step with each other and with the sparse map
+    virtual void sort_by_entity(size_t first, size_t last) = 0;
 };
 
+// Readable name of T from the compiler's signature of this function
+template <typename T> constexpr auto type_name() -> std::string_view {
+    const std::string_view signature =
+            std::source_location::current().function_name();
+    // GCC/Clang: "... [with T = Name; ...]" / "... [T = Name]"
+    if (const auto start = signature.find("T = ");
+            start != std::string_view::npos) {
+        const auto first = start + 4;
+        const auto last  = signature.find_first_of(";]", first);
+        return signature.substr(first, last - first);
+    }
+    // MSVC: "... type_name<struct Name>(void)"
+    const auto first = signature.find('<') + 1;
+    const auto last  = signature.rfind('>');
+    return signature.substr(first, last - first);
+}
+
+// Sparse set for one component type. Anyone can read it; only the Registry
+// that owns it can change it, since insert/remove/sort/adopt behind the
+// Registry's back would break owned-group packing and change stamps.
 export template <typename Component>
 class ComponentStorage final : public IComponentStorage {
 public:
-    void insert(const Entity entity, Component component) {
+    auto get(const Entity entity) const -> const Component* {
+        if (entity.index >= entity_to_index_.size()) {
+            return nullptr;
+        }
+        auto idx = entity_to_index_[entity.index];
+        return idx < 0 ? nullptr : &components_[idx];
+    }
+
+    // Removals at `version` or later, oldest first, or nullopt if some of
+    // them were already trimmed (the observer has to resync from scratch)
+    [[nodiscard]] auto removals_since(const uint32_t version) const
+            -> std::optional<std::span<const StorageRemoval>> {
+        if (version < removals_from_) {
+            return std::nullopt;
+        }
+        const auto first = std::ranges::partition_point(removals_,
+                [&](const StorageRemoval& removal) {
+                    return removal.version < version;
+                });
+        return std::span(first, removals_.end());
+    }
+
+    [[nodiscard]] auto entities_with_component() const -> const std::vector<Entity>& {
+        return entities_;
+    }
+
+    // Last-changed version of each dense component, parallel to
+    // entities_with_component()
+    [[nodiscard]] auto versions() const -> std::span<const uint32_t> {
+        return versions_;
+    }
+
+    // Raw dense/sparse arrays, exposed for snapshotting and group walks
+    [[nodiscard]] auto dense_components() const -> std::span<const Component> {
+        return components_;
+    }
+
+    [[nodiscard]] auto sparse_indices() const -> std::span<const int32_t> {
+        return entity_to_index_;
+    }
+
+    [[nodiscard]] auto stats() const -> StorageStats override {
+        // Per array: the dense arrays grow independently (adopt, reserve),
+        // so their capacities need not match
+        const auto held = [](const auto& array) {
+            return array.capacity() * sizeof(array[0]);
+        };
+        const auto unused = [](const auto& array) {
+            return (array.capacity() - array.size()) * sizeof(array[0]);
+        };
+        const size_t count  = components_.size();
+        const size_t sparse = entity_to_index_.size();
+
+        size_t out_of_order = 0;
+        for (size_t idx = 1; idx < count; ++idx) {
+            out_of_order += entities_[idx].index < entities_[idx - 1].index;
+        }
+
+        return {.type_name    = type_name<Component>(),
+                .count        = count,
+                .capacity     = components_.capacity(),
+                .sparse_slots = sparse,
+                .bytes = held(components_) + held(entities_) +
+                         held(versions_) + held(entity_to_index_),
+                .slack_bytes = unused(components_) + unused(entities_) +
+                               unused(versions_) + unused(entity_to_index_),
+                .sparse_fill = sparse == 0 ? 1.F
+                                           : static_cast<float>(count) /
+                                                     static_cast<float>(sparse),
+                .disorder = count < 2 ? 0.F
+                                      : static_cast<float>(out_of_order) /
+                                                static_cast<float>(count - 1)};
+    }
+
+    [[nodiscard]] auto size() const -> size_t override {
+        return components_.size();
+    }
+
+    [[nodiscard]] auto dense_entities() const
+            -> std::span<const Entity> override {
+        return entities_;
+    }
+
+    // Dense slot of the entity's component, or -1 if it has none
+    [[nodiscard]] auto dense_index(const Entity entity) const
+            -> int32_t override {
+        return entity.index < entity_to_index_.size()
+                       ? entity_to_index_[entity.index]
+                       : -1;
+    }
+
+private:
+    friend class Registry;
+
+    void insert(const Entity entity, Component component,
+                const uint32_t version = 0) {
         if (entity.index >= entity_to_index_.size()) {
             entity_to_index_.resize(entity.index + 1, -1);
         }
@@ -28,6 +204,7 @@ public:
         assert(std::cmp_equal(entity_to_index_[entity.index], -1));
         components_.push_back(std::move(component));
         entities_.push_back(entity);
+        versions_.push_back(version);
         entity_to_index_[entity.index] = components_.size() - 1;
     }
 
@@ -39,7 +216,7 @@ public:
         return idx < 0 ? nullptr : &components_[idx];
     }
 
-    void remove(const Entity entity) override {
+    void remove(const Entity entity, const uint32_t version) override {
         // 1) If we’ve never resized out to this entity’s index, nothing to do
         if (entity.index >= entity_to_index_.size()) {
             return;
@@ -58,6 +235,7 @@ public:
         // 4) Overwrite the slot at idx by moving in the last component
         components_[idx] = std::move(components_[last]);
         entities_[idx]   = entities_[last];
+        versions_[idx]   = versions_[last];
 
         // 5) Update the sparse map entry for that moved entity
         //    (it used to point at 'last', now it points at 'idx')
@@ -66,17 +244,167 @@ public:
         // 6) Shrink the dense arrays by removing the now‑moved last slot
         components_.pop_back();
         entities_.pop_back();
+        versions_.pop_back();
 
         // 7) Finally, mark the removed entity’s slot as empty
         entity_to_index_[entity.index] = -1;
+
+        // 8) Log it, so change observers see the component go
+        removals_.push_back({.entity = entity, .version = version});
     }
 
-    [[nodiscard]] auto entities_with_component() const -> const std::vector<Entity>& {
-        return entities_;
+    void trim_removals(const uint32_t oldest) override {
+        if (oldest <= removals_from_) {
+            return;
+        }
+        const auto last = std::ranges::partition_point(removals_,
+                [&](const StorageRemoval& removal) {
+                    return removal.version < oldest;
+                });
+        removals_.erase(removals_.begin(), last);
+        removals_from_ = oldest;
+    }
+
+    void stamp_all(const uint32_t version) override {
+        std::ranges::fill(versions_, version);
+        removals_.clear();
+        removals_from_ = version;
+    }
+
+    // Stamp the entity's component as changed at `version` (see
+    // Registry::patch). No-op if the entity has no component here.
+    void touch(const Entity entity, const uint32_t version) {
+        if (entity.index >= entity_to_index_.size()) {
+            return;
+        }
+        if (const auto idx = entity_to_index_[entity.index]; idx >= 0) {
+            versions_[idx] = version;
+        }
+    }
+
+    void touch_dense(const size_t dense_index, const uint32_t version) {
+        versions_[dense_index] = version;
+    }
+
+    // get() that also stamps the component as changed at `version`
+    auto patch(const Entity entity, const uint32_t version) -> Component* {
+        if (entity.index >= entity_to_index_.size()) {
+            return nullptr;
+        }
+        const auto idx = entity_to_index_[entity.index];
+        if (idx < 0) {
+            return nullptr;
+        }
+        versions_[idx] = version;
+        return &components_[idx];
+    }
+
+    [[nodiscard]] auto dense_components() -> std::span<Component> {
+        return components_;
+    }
+
+    // Replace the whole storage with previously captured arrays in one bulk
+    // copy each; no per-entity insert() bookkeeping. Every component is
+    // stamped with `version`. What the old arrays held is not logged as
+    // removed, so the removal log restarts at `version`.
+    void adopt(std::span<const Component> components,
+               std::span<const Entity>    entities,
+               std::span<const int32_t>   entity_to_index,
+               const uint32_t             version = 0) {
+        assert(components.size() == entities.size());
+        components_.assign(components.begin(), components.end());
+        entities_.assign(entities.begin(), entities.end());
+        entity_to_index_.assign(entity_to_index.begin(), entity_to_index.end());
+        versions_.assign(components.size(), version);
+        removals_.clear();
+        removals_from_ = version;
+    }
+
+    void shrink_to_fit() override {
+        // Trailing sparse slots only ever say "no component"
+        while (!entity_to_index_.empty() && entity_to_index_.back() < 0) {
+            entity_to_index_.pop_back();
+        }
+
+        components_.shrink_to_fit();
+        entities_.shrink_to_fit();
+        versions_.shrink_to_fit();
+        entity_to_index_.shrink_to_fit();
+    }
+
+    void swap_dense(const size_t lhs, const size_t rhs) override {
+        if (lhs == rhs) {
+            return;
+        }
+        using std::swap;
+        swap(components_[lhs], components_[rhs]);
+        swap(entities_[lhs], entities_[rhs]);
+        swap(versions_[lhs], versions_[rhs]);
+        entity_to_index_[entities_[lhs].index] = static_cast<int32_t>(lhs);
+        entity_to_index_[entities_[rhs].index] = static_cast<int32_t>(rhs);
+    }
+
+    void sort_by_entity(const size_t first, const size_t last) override {
+        sort_slots(first, last, [&](const uint32_t lhs, const uint32_t rhs) {
+            return entities_[lhs].index < entities_[rhs].index;
+        });
+    }
+
+    // Reorder dense slots [first, last) so compare(lhs, rhs) holds between
+    // neighbours; equal components keep their relative order. The sparse map
+    // follows. See Registry::sort, which keeps owned groups aligned.
+    template <typename Compare>
+    void sort(Compare compare, const size_t first, const size_t last) {
+        sort_slots(first, last, [&](const uint32_t lhs, const uint32_t rhs) {
+            return compare(std::as_const(components_[lhs]),
+                    std::as_const(components_[rhs]));
+        });
+    }
+
+    template <typename SlotLess>
+    void sort_slots(const size_t first, const size_t last, SlotLess less) {
+        assert(first <= last && last <= components_.size());
+        std::vector<uint32_t> order(components_.size());
+        std::iota(order.begin(), order.end(), 0U);
+
+        const auto range = std::span(order).subspan(first, last - first);
+        if (std::ranges::is_sorted(range, less)) {
+            return;
+        }
+        std::ranges::stable_sort(range, less);
+        permute(order);
+    }
+
+    // Rebuild the dense arrays so slot i holds what was in slot order[i],
+    // and repoint the sparse map at the new slots
+    void permute(std::span<const uint32_t> order) {
+        assert(order.size() == components_.size());
+        std::vector<Component> components;
+        std::vector<Entity>    entities;
+        std::vector<uint32_t>  versions;
+        components.reserve(order.size());
+        entities.reserve(order.size());
+        versions.reserve(order.size());
+        for (const uint32_t from : order) {
+            components.push_back(std::move(components_[from]));
+            entities.push_back(entities_[from]);
+            versions.push_back(versions_[from]);
+        }
+        components_ = std::move(components);
+        entities_   = std::move(entities);
+        versions_   = std::move(versions);
+
+        for (size_t idx = 0; idx < entities_.size(); ++idx) {
+            entity_to_index_[entities_[idx].index] = static_cast<int32_t>(idx);
+        }
     }
 
-private:
     std::vector<Component> components_;
     std::vector<Entity>    entities_;
+    std::vector<uint32_t>  versions_; // parallel to components_
     std::vector<int32_t>   entity_to_index_;
+
+    // Removals in version order, complete from removals_from_ onwards
+    std::vector<StorageRemoval> removals_;
+    uint32_t                    removals_from_{0};
 };
\ No newline at end of file
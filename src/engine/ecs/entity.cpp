@@ -1,5 +1,7 @@
 module;
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 module Engine.Ecs.Entity;
 
@@ -9,10 +11,12 @@ auto EntityManager::create_entity() -> Entity {
         index = free_indices_.back();
         free_indices_.pop_back();
         ++generations_[index];
+        ++recycled_;
     } else {
         index = next_index_++;
         generations_.push_back(0);
     }
+    ++created_;
     return Entity{.index = index, .generation = generations_[index]};
 }
 void EntityManager::destroy_entity(const Entity entity) {
@@ -21,9 +25,42 @@ void EntityManager::destroy_entity(const Entity entity) {
     }
     free_indices_.push_back(entity.index);
     ++generations_[entity.index];
+    ++destroyed_;
 }
 
 auto EntityManager::is_alive(const Entity& entity) const -> bool {
     return entity.index < generations_.size() &&
            generations_[entity.index] == entity.generation;
+}
+
+auto EntityManager::stats() const -> EntityStats {
+    const size_t held = generations_.capacity() + free_indices_.capacity();
+    return {.alive          = generations_.size() - free_indices_.size(),
+            .index_capacity = generations_.size(),
+            .free_indices   = free_indices_.size(),
+            .bytes          = held * sizeof(uint32_t),
+            .created        = created_,
+            .destroyed      = destroyed_,
+            .recycled       = recycled_};
+}
+
+void EntityManager::shrink_to_fit() {
+    generations_.shrink_to_fit();
+    free_indices_.shrink_to_fit();
+}
+
+auto EntityManager::generations() const -> std::span<const uint32_t> {
+    return generations_;
+}
+
+auto EntityManager::free_indices() const -> std::span<const uint32_t> {
+    return free_indices_;
+}
+
+void EntityManager::restore(const std::span<const uint32_t> generations,
+        const std::span<const uint32_t> free_indices) {
+    generations_.assign(generations.begin(), generations.end());
+    free_indices_.assign(free_indices.begin(), free_indices.end());
+    // Indices are handed out densely, so the next fresh one is the count
+    next_index_ = static_cast<uint32_t>(generations_.size());
 }
\ No newline at end of file
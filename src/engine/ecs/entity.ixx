@@ -1,5 +1,7 @@
 module;
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 export module Engine.Ecs.Entity;
@@ -9,6 +11,18 @@ export struct Entity {
     uint32_t generation;
 };
 
+// Entity bookkeeping footprint and lifetime churn; rates come from comparing
+// two samples
+export struct EntityStats {
+    size_t   alive{0};
+    size_t   index_capacity{0}; // indices ever handed out
+    size_t   free_indices{0};   // destroyed, waiting to be recycled
+    size_t   bytes{0};          // heap bytes held by the bookkeeping
+    uint64_t created{0};
+    uint64_t destroyed{0};
+    uint64_t recycled{0}; // creations that reused a freed index
+};
+
 export class EntityManager {
 public:
     EntityManager() = default;
@@ -16,8 +30,26 @@ public:
     auto destroy_entity(Entity entity) -> void;
     [[nodiscard]] auto is_alive(const Entity& entity) const -> bool;
 
+    [[nodiscard]] auto stats() const -> EntityStats;
+
+    // Release unused bookkeeping capacity
+    void shrink_to_fit();
+
+    // Raw bookkeeping, exposed for snapshotting
+    [[nodiscard]] auto generations() const -> std::span<const uint32_t>;
+    [[nodiscard]] auto free_indices() const -> std::span<const uint32_t>;
+
+    // Replace all bookkeeping with previously captured state
+    void restore(std::span<const uint32_t> generations,
+                 std::span<const uint32_t> free_indices);
+
 private:
     uint32_t next_index_ {0};
     std::vector<uint32_t> generations_;
     std::vector<uint32_t> free_indices_;
+
+    // Lifetime churn counters
+    uint64_t created_ {0};
+    uint64_t destroyed_ {0};
+    uint64_t recycled_ {0};
 };
\ No newline at end of file
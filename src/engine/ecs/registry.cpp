@@ -1,5 +1,11 @@
 module;
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <ranges>
+#include <typeindex>
+#include <utility>
+#include <vector>
 
 module Engine.Ecs.Registry;
 
@@ -11,9 +17,176 @@ void Registry::destroy_entity(const Entity entity) {
     if (!entity_manager_.is_alive(entity)) {
         return;
     }
-    // Remove all component data for this entity
+    // Leave every group first, then remove all component data for this
+    // entity
+    for (OwnedGroup& group : groups_) {
+        leave_group(group, entity);
+    }
     for (const auto& storage : component_storages_ | std::views::values) {
-        storage->remove(entity);
+        storage->remove(entity, tick_);
     }
     entity_manager_.destroy_entity(entity);
+}
+
+void Registry::restore(Registry&& source) {
+    std::vector<void (*)(Registry&)> declarations;
+    declarations.reserve(groups_.size());
+    for (const OwnedGroup& group : groups_) {
+        declarations.push_back(group.declare);
+    }
+
+    // Ticks keep moving forward and the whole restore lands in a fresh one,
+    // so change observers see every restored component as changed
+    entity_manager_     = std::move(source.entity_manager_);
+    tick_               = std::max(tick_, source.tick_) + 1;
+    component_storages_ = std::move(source.component_storages_);
+    for (const auto& storage : component_storages_ | std::views::values) {
+        storage->stamp_all(tick_);
+    }
+    groups_.clear();
+    group_index_.clear();
+
+    // Declaring packs whatever already qualifies, in any prior arrangement
+    for (const auto declare : declarations) {
+        declare(*this);
+    }
+}
+
+auto Registry::entity_manager() const -> const EntityManager& {
+    return entity_manager_;
+}
+
+auto Registry::entity_manager() -> EntityManager& {
+    return entity_manager_;
+}
+
+auto Registry::current_tick() const -> uint32_t {
+    return tick_;
+}
+
+void Registry::advance_tick() {
+    ++tick_;
+    if (tick_ > REMOVAL_LOG_TICKS) {
+        for (const auto& storage : component_storages_ | std::views::values) {
+            storage->trim_removals(tick_ - REMOVAL_LOG_TICKS);
+        }
+    }
+}
+
+auto Registry::stats() const -> RegistryStats {
+    RegistryStats stats;
+    stats.entities    = entity_manager_.stats();
+    stats.total_bytes = stats.entities.bytes;
+
+    stats.components.reserve(component_storages_.size());
+    for (const auto& storage : component_storages_ | std::views::values) {
+        const StorageStats& component =
+                stats.components.emplace_back(storage->stats());
+        stats.total_bytes += component.bytes;
+        stats.slack_bytes += component.slack_bytes;
+    }
+    std::ranges::sort(
+            stats.components, std::ranges::greater{}, &StorageStats::bytes);
+    return stats;
+}
+
+void Registry::shrink_to_fit() {
+    for (const auto& storage : component_storages_ | std::views::values) {
+        storage->shrink_to_fit();
+    }
+    entity_manager_.shrink_to_fit();
+}
+
+void Registry::compact() {
+    for (const auto& [type, storage] : component_storages_) {
+        // Each group storage holds the same members up front, so sorting
+        // every one of them by entity index keeps them aligned
+        const OwnedGroup* group = group_of(type);
+        const size_t      split = group != nullptr ? group->size : 0;
+        storage->sort_by_entity(0, split);
+        storage->sort_by_entity(split, storage->size());
+        storage->shrink_to_fit();
+    }
+    entity_manager_.shrink_to_fit();
+}
+
+//-----------------------------------------------------------------------------
+// Owned groups
+//-----------------------------------------------------------------------------
+auto Registry::group_of(const std::type_index type) -> OwnedGroup* {
+    if (groups_.empty()) {
+        return nullptr;
+    }
+    const auto iter = group_index_.find(type);
+    return iter == group_index_.end() ? nullptr : &groups_[iter->second];
+}
+
+auto Registry::joined_group(const IComponentStorage* first,
+        const IComponentStorage* second) const -> const OwnedGroup* {
+    for (const OwnedGroup& group : groups_) {
+        const auto& owned = group.storages;
+        if (owned.size() == 2 && first != second &&
+                (owned[0] == first || owned[1] == first) &&
+                (owned[0] == second || owned[1] == second)) {
+            return &group;
+        }
+    }
+    return nullptr;
+}
+
+void Registry::enter_group(OwnedGroup& group, const Entity entity) {
+    const int32_t slot = group.storages.front()->dense_index(entity);
+    if (slot >= 0 && std::cmp_less(slot, group.size)) {
+        return; // already a member
+    }
+    for (const IComponentStorage* storage : group.storages) {
+        if (storage->dense_index(entity) < 0) {
+            return; // still missing an owned type
+        }
+    }
+
+    // Swap into the first slot past the packed section of every storage
+    for (IComponentStorage* storage : group.storages) {
+        storage->swap_dense(
+                static_cast<size_t>(storage->dense_index(entity)), group.size);
+    }
+    ++group.size;
+}
+
+void Registry::leave_group(OwnedGroup& group, const Entity entity) {
+    const int32_t slot = group.storages.front()->dense_index(entity);
+    if (slot < 0 || std::cmp_greater_equal(slot, group.size)) {
+        return; // not a member
+    }
+
+    // Swap with the last member of every storage, then shrink the section
+    --group.size;
+    for (IComponentStorage* storage : group.storages) {
+        storage->swap_dense(
+                static_cast<size_t>(storage->dense_index(entity)), group.size);
+    }
+}
+
+void Registry::pack_group(OwnedGroup& group) {
+    // Entering swaps slots, so walk a copy of the leading storage's entities
+    group.size         = 0;
+    const auto leading = group.storages.front()->dense_entities();
+    const std::vector<Entity> existing(leading.begin(), leading.end());
+    for (const Entity entity : existing) {
+        enter_group(group, entity);
+    }
+}
+
+void Registry::align_group(OwnedGroup& group, const IComponentStorage& leader) {
+    const auto members = leader.dense_entities().first(group.size);
+    for (IComponentStorage* storage : group.storages) {
+        if (storage == &leader) {
+            continue;
+        }
+        // Slots before idx are already placed, so the member is at or past it
+        for (size_t idx = 0; idx < members.size(); ++idx) {
+            storage->swap_dense(idx,
+                    static_cast<size_t>(storage->dense_index(members[idx])));
+        }
+    }
 }
\ No newline at end of file
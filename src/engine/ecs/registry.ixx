@@ -1,13 +1,30 @@
 module;
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 export module Engine.Ecs.Registry;
 
 import Engine.Ecs.Entity;
-import Engine.Ecs.ComponentStorage;
+export import :ComponentStorage;
+
+// Registry-wide memory and occupancy, see Registry::stats()
+export struct RegistryStats {
+    EntityStats               entities;
+    std::vector<StorageStats> components; // largest footprint first
+    size_t                    total_bytes{0};
+    size_t                    slack_bytes{0};
+};
+
+// Ticks of component removals each storage keeps for change observers; an
+// observer that falls further behind resyncs from the full storage
+export constexpr uint32_t REMOVAL_LOG_TICKS = 8;
 
 export class Registry {
 public:
@@ -30,24 +47,129 @@ public:
     template <typename C>
     [[nodiscard]] auto has_component(Entity entity) const -> bool;
 
-    // Retrieve a reference to an entity's component of type C
+    // Retrieve a reference to an entity's component of type C. Mutable
+    // access stamps the component as changed in the current tick (see
+    // patch); read through a const Registry to leave it unstamped.
     template <typename C> auto get_component(Entity entity) -> C&;
+    template <typename C>
+    [[nodiscard]] auto get_component(Entity entity) const -> const C&;
+
+    // Mutable access that stamps the component as changed in the current
+    // tick, so change observers (replication) pick up the write. Same as
+    // non-const get_component; spelled out where a write is intended.
+    template <typename C> auto patch(Entity entity) -> C&;
 
-    // Run func(comp1, comp2) for each entity that has both C1 and C2
+    // Run func(comp1, comp2) for each entity that has both C1 and C2. If a
+    // group owns exactly C1 and C2 this is a lockstep walk of both arrays.
+    // A component the callback accepts as const is passed as const; one it
+    // takes by mutable reference is stamped as changed, like patch().
     template <typename C1, typename C2, typename Func>
     auto for_each(Func func) -> void;
 
+    // Declare an owned group: entities having every Owned type are kept
+    // packed at the front of those storages, in the same order in each.
+    // A type belongs to at most one group. Groups survive restore() but not
+    // plain assignment from another Registry.
+    template <typename... Owned> void group();
+
+    // Stable-sort C's storage with compare(const C&, const C&), e.g. by
+    // spatial cell for render order. Members of C's group are sorted among
+    // themselves and the group's other storages follow them.
+    template <typename C, typename Compare> void sort(Compare compare);
+
+    // Run func(entity, comp) for each entity that has a C; const/stamping
+    // rules as for for_each
+    template <typename C, typename Func> auto for_each_entity(Func func) -> void;
+
     // Return all entities that currently have a component of type C
     template <typename C>
     [[nodiscard]] auto entities_with() const -> std::vector<Entity>;
 
+    // Read-only view of the storage for C, or nullptr if no C was ever added.
+    // Storages are only mutable through the Registry, which keeps owned
+    // groups packed.
+    template <typename C>
+    [[nodiscard]] auto find_storage() const -> const ComponentStorage<C>*;
+
+    // Replace C's storage with previously captured dense and sparse arrays
+    // (e.g. from a snapshot), stamped with the current tick. A group owning
+    // C is re-packed over the new data. The arrays must be consistent with
+    // each other and with entity_manager().
+    template <typename C>
+    void adopt(std::span<const C> components, std::span<const Entity> entities,
+               std::span<const int32_t> entity_to_index);
+
+    // Take over `source`'s entities and components (e.g. a freshly loaded
+    // snapshot). This registry keeps its group declarations and re-packs
+    // them over the new data; `source`'s groups are dropped. The tick moves
+    // past both registries' ticks and every component is stamped with it.
+    void restore(Registry&& source);
+
+    // Entity bookkeeping (generations, free list)
+    [[nodiscard]] auto entity_manager() const -> const EntityManager&;
+    auto               entity_manager() -> EntityManager&;
+
+    // Change tracking: components added or patched are stamped with the
+    // current tick; advancing it closes the tick for observers such as the
+    // replication encoder. The game loop advances once per simulation step.
+    // Removals are logged per storage for the last REMOVAL_LOG_TICKS ticks
+    // (see ComponentStorage::removals_since).
+    [[nodiscard]] auto current_tick() const -> uint32_t;
+    void               advance_tick();
+
+    // Per-type counts, bytes, slack and fragmentation, plus entity churn.
+    // Walks every storage, so sample it rather than calling it every frame.
+    [[nodiscard]] auto stats() const -> RegistryStats;
+
+    // Release unused capacity in every storage and the entity bookkeeping
+    void shrink_to_fit();
+
+    // Sort every storage's dense arrays by entity index (group members and
+    // the rest separately) and shrink them. Invalidates component
+    // references; do not call while iterating.
+    void compact();
+
 private:
+    // Entities [0, size) have every owned type and sit at the same dense slot
+    // in each of the group's storages
+    struct OwnedGroup {
+        std::vector<IComponentStorage*> storages;
+        size_t                          size{0};
+        void (*declare)(Registry&){nullptr}; // re-runs group<Owned...>()
+    };
+
     // Helper: get the storage component for type C, or nullptr
     template <typename C> auto get_storage() -> ComponentStorage<C>*;
 
+    // Helper: the storage for C, created on first use
+    template <typename C> auto storage() -> ComponentStorage<C>&;
+
+    // Helper: the component as the callback may see it, see for_each
+    template <bool Writes, typename C>
+    static auto access(C& component)
+            -> std::conditional_t<Writes, C&, const C&> {
+        return component;
+    }
+
+    // Group bookkeeping; each is a handful of dense swaps
+    auto group_of(std::type_index type) -> OwnedGroup*;
+    auto joined_group(const IComponentStorage* first,
+                      const IComponentStorage* second) const
+            -> const OwnedGroup*;
+    static void enter_group(OwnedGroup& group, Entity entity);
+    static void leave_group(OwnedGroup& group, Entity entity);
+    // Rebuild the packed section from scratch, whatever the current order
+    static void pack_group(OwnedGroup& group);
+    // Move the other storages' group members into `leader`'s order
+    static void align_group(OwnedGroup& group, const IComponentStorage& leader);
+
     EntityManager entity_manager_;
+    uint32_t      tick_{1}; // 0 is reserved for "never changed"
     std::unordered_map<std::type_index, std::unique_ptr<IComponentStorage>>
             component_storages_;
+
+    std::vector<OwnedGroup>                     groups_;
+    std::unordered_map<std::type_index, size_t> group_index_; // by owned type
 };
 
 //------------------------------------------------------------------------------
@@ -91,9 +213,15 @@ auto Registry::add_component(Entity entity, Args&&... args) -> C& {
     //    and the “reference collapse” rules make sure:
     //      - if T = U& then T&& → U&  (lvalue)
     //      - if T = U  then T&& → U&& (rvalue)
-    storage->insert(entity, C{std::forward<Args>(args)...});
+    storage->insert(entity, C{std::forward<Args>(args)...}, tick_);
+
+    // 6) If C is owned by a group and the entity now has all of its types,
+    //    swap it into the group's packed front section.
+    if (OwnedGroup* group = group_of(type_id)) {
+        enter_group(*group, entity);
+    }
 
-    // 6) Return a reference to the newly‐inserted component, so the caller
+    // 7) Return a reference to the newly‐inserted component, so the caller
     //    can immediately read or modify it.
     return *storage->get(entity);
 }
@@ -102,7 +230,13 @@ template <typename C> void Registry::remove_component(Entity entity) {
     const auto type_id = std::type_index(typeid(C));
     if (const auto iter = component_storages_.find(type_id);
             iter != component_storages_.end()) {
-        static_cast<ComponentStorage<C>*>(iter->second.get())->remove(entity);
+        // Leave the group first, so the swap-and-pop below happens outside
+        // its packed section
+        if (OwnedGroup* group = group_of(type_id)) {
+            leave_group(*group, entity);
+        }
+        static_cast<ComponentStorage<C>*>(iter->second.get())
+                ->remove(entity, tick_);
     }
 }
 
@@ -131,10 +265,18 @@ auto Registry::has_component(Entity entity) const -> bool {
 }
 
 template <typename C> auto Registry::get_component(const Entity entity) -> C& {
+    return patch<C>(entity);
+}
+
+template <typename C>
+auto Registry::get_component(const Entity entity) const -> const C& {
     assert(has_component<C>(entity) && "Missing component");
-    auto* storage = static_cast<ComponentStorage<C>*>(
-            component_storages_.at(std::type_index(typeid(C))).get());
-    return *storage->get(entity);
+    return *find_storage<C>()->get(entity);
+}
+
+template <typename C> auto Registry::patch(const Entity entity) -> C& {
+    assert(has_component<C>(entity) && "Missing component");
+    return *get_storage<C>()->patch(entity, tick_);
 }
 
 template <typename C1, typename C2, typename Func>
@@ -150,33 +292,61 @@ auto Registry::for_each(Func func) -> void {
         return;
     }
 
-    // 3) Get the lists of entities that currently have each component.
+    // 3) A callback that can take a component as const only reads it. Pass
+    //    those as const; stamp the ones it takes mutably, as patch() would.
+    constexpr bool WRITES1 = !std::is_invocable_v<Func&, const C1&, C2&>;
+    constexpr bool WRITES2 = !std::is_invocable_v<Func&, C1&, const C2&>;
+    const auto     visit   = [&](const Entity entity, C1& comp1, C2& comp2) {
+        if constexpr (WRITES1) {
+            storage1->touch(entity, tick_);
+        }
+        if constexpr (WRITES2) {
+            storage2->touch(entity, tick_);
+        }
+        func(access<WRITES1>(comp1), access<WRITES2>(comp2));
+    };
+
+    // 4) An owned group of exactly C1 and C2 already has every match packed
+    //    at the same slots of both arrays: walk them in lockstep.
+    if (const OwnedGroup* group = joined_group(storage1, storage2)) {
+        const auto components1 = storage1->dense_components();
+        const auto components2 = storage2->dense_components();
+        const auto entities    = storage1->dense_entities();
+        for (size_t idx = 0; idx < group->size; ++idx) {
+            visit(entities[idx], components1[idx], components2[idx]);
+        }
+        return;
+    }
+
+    // 5) Get the lists of entities that currently have each component.
     //    These are the “dense” arrays we maintained in ComponentStorage.
     const auto& list1 = storage1->entities_with_component();
     const auto& list2 = storage2->entities_with_component();
 
-    // 4) For efficiency, iterate over the *smaller* list and check membership
+    // 6) For efficiency, iterate over the *smaller* list and check membership
     //    in the larger one. This minimizes the total number of lookups.
     if (list1.size() <= list2.size()) {
-        // 4a) list1 is smaller (or equal).
+        // 6a) list1 is smaller (or equal).
         for (auto entity : list1) {
-            // 5a) Check if this entity also has C2
+            // 7a) Check if this entity also has C2
             if (storage2->get(entity)) {
-                // 6a) Both components exist: retrieve them and invoke the
+                // 8a) Both components exist: retrieve them and invoke the
                 // callback
-                func(*storage1->get(entity), // C1&
+                visit(entity,
+                        *storage1->get(entity), // C1&
                         *storage2->get(entity) // C2&
                 );
             }
         }
     } else {
-        // 4b) list2 is smaller.
+        // 6b) list2 is smaller.
         for (auto entity : list2) {
-            // 5b) Check if this entity also has C1
+            // 7b) Check if this entity also has C1
             if (storage1->get(entity)) {
-                // 6b) Both components exist: retrieve them and invoke the
+                // 8b) Both components exist: retrieve them and invoke the
                 // callback
-                func(*storage1->get(entity), // C1&
+                visit(entity,
+                        *storage1->get(entity), // C1&
                         *storage2->get(entity) // C2&
                 );
             }
@@ -184,6 +354,26 @@ auto Registry::for_each(Func func) -> void {
     }
 }
 
+template <typename C, typename Func>
+auto Registry::for_each_entity(Func func) -> void {
+    auto* storage = get_storage<C>();
+    if (!storage) {
+        return;
+    }
+
+    // Walk the dense arrays directly; a callback taking C mutably stamps
+    // each component, as in for_each
+    constexpr bool WRITES = !std::is_invocable_v<Func&, Entity, const C&>;
+    const auto     components = storage->dense_components();
+    const auto     entities   = storage->dense_entities();
+    for (size_t idx = 0; idx < entities.size(); ++idx) {
+        if constexpr (WRITES) {
+            storage->touch_dense(idx, tick_);
+        }
+        func(entities[idx], access<WRITES>(components[idx]));
+    }
+}
+
 template <typename C>
 auto Registry::entities_with() const -> std::vector<Entity> {
     const auto iter = component_storages_.find(std::type_index(typeid(C)));
@@ -195,6 +385,62 @@ auto Registry::entities_with() const -> std::vector<Entity> {
     return storage->entities_with_component();
 }
 
+template <typename... Owned> void Registry::group() {
+    static_assert(sizeof...(Owned) >= 2, "A group joins at least two types");
+    assert((!group_index_.contains(std::type_index(typeid(Owned))) && ...) &&
+            "Component type is already owned by a group");
+
+    OwnedGroup& group = groups_.emplace_back();
+    group.storages    = {&storage<Owned>()...};
+    group.declare     = [](Registry& registry) { registry.group<Owned...>(); };
+    (group_index_.emplace(std::type_index(typeid(Owned)), groups_.size() - 1),
+            ...);
+
+    // Pack the entities that already qualify
+    pack_group(group);
+}
+
+template <typename C, typename Compare> void Registry::sort(Compare compare) {
+    auto&       target = storage<C>();
+    OwnedGroup* group  = group_of(std::type_index(typeid(C)));
+    if (group == nullptr) {
+        target.sort(compare, 0, target.size());
+        return;
+    }
+
+    // Group members stay in front: sort them, carry the other storages
+    // along, then sort the rest of C separately
+    target.sort(compare, 0, group->size);
+    align_group(*group, target);
+    target.sort(compare, group->size, target.size());
+}
+
+template <typename C> auto Registry::storage() -> ComponentStorage<C>& {
+    auto& slot = component_storages_[std::type_index(typeid(C))];
+    if (!slot) {
+        slot = std::make_unique<ComponentStorage<C>>();
+    }
+    return *static_cast<ComponentStorage<C>*>(slot.get());
+}
+
+template <typename C>
+void Registry::adopt(const std::span<const C> components,
+        const std::span<const Entity> entities,
+        const std::span<const int32_t> entity_to_index) {
+    storage<C>().adopt(components, entities, entity_to_index, tick_);
+    if (OwnedGroup* group = group_of(std::type_index(typeid(C)))) {
+        pack_group(*group);
+    }
+}
+
+template <typename C>
+auto Registry::find_storage() const -> const ComponentStorage<C>* {
+    const auto iter = component_storages_.find(std::type_index(typeid(C)));
+    return iter == component_storages_.end()
+                   ? nullptr
+                   : static_cast<const ComponentStorage<C>*>(iter->second.get());
+}
+
 template <typename C> auto Registry::get_storage() -> ComponentStorage<C>* {
     const auto iter = component_storages_.find(std::type_index(typeid(C)));
     return iter == component_storages_.end()
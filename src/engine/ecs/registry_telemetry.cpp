@@ -0,0 +1,128 @@
+module;
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <span>
+#include <string>
+#include <vector>
+
+module Engine.Ecs.Telemetry;
+
+static auto to_kib(const size_t bytes) -> double {
+    return static_cast<double>(bytes) / 1024.0;
+}
+
+static auto to_percent(const float fraction) -> int {
+    return static_cast<int>((fraction * 100.F) + 0.5F);
+}
+
+RegistryTelemetry::RegistryTelemetry(const Clock::duration interval)
+    : interval_(interval) {}
+
+auto RegistryTelemetry::update(const Registry& registry,
+        const Clock::time_point now) -> bool {
+    if (samples_ != 0 && now - last_sample_ < interval_) {
+        return false;
+    }
+
+    stats_ = registry.stats();
+
+    // Rates need two samples; the first one only sets the baseline. A
+    // counter that went backwards means the entity bookkeeping was replaced
+    // (Registry::restore after a load): report no churn and re-seed.
+    const bool restarted = stats_.entities.created < last_created_ ||
+                           stats_.entities.destroyed < last_destroyed_;
+    if (samples_ != 0 && restarted) {
+        created_per_second_   = 0.0;
+        destroyed_per_second_ = 0.0;
+    } else if (samples_ != 0) {
+        const double seconds =
+                std::chrono::duration<double>(now - last_sample_).count();
+        created_per_second_ =
+                static_cast<double>(stats_.entities.created - last_created_) /
+                seconds;
+        destroyed_per_second_ =
+                static_cast<double>(
+                        stats_.entities.destroyed - last_destroyed_) /
+                seconds;
+    }
+    last_created_   = stats_.entities.created;
+    last_destroyed_ = stats_.entities.destroyed;
+    last_sample_    = now;
+    ++samples_;
+
+    format_lines();
+    return true;
+}
+
+auto RegistryTelemetry::stats() const -> const RegistryStats& {
+    return stats_;
+}
+
+auto RegistryTelemetry::samples() const -> uint64_t {
+    return samples_;
+}
+
+auto RegistryTelemetry::created_per_second() const -> double {
+    return created_per_second_;
+}
+
+auto RegistryTelemetry::destroyed_per_second() const -> double {
+    return destroyed_per_second_;
+}
+
+auto RegistryTelemetry::overlay_lines() const -> std::span<const std::string> {
+    return lines_;
+}
+
+auto RegistryTelemetry::summary() const -> std::string {
+    const EntityStats& entities = stats_.entities;
+    std::string        line     = std::format(
+            "ecs: entities={} free={} types={} mem={:.1f}KiB "
+            "slack={:.1f}KiB created/s={:.1f} destroyed/s={:.1f}",
+            entities.alive,
+            entities.free_indices,
+            stats_.components.size(),
+            to_kib(stats_.total_bytes),
+            to_kib(stats_.slack_bytes),
+            created_per_second_,
+            destroyed_per_second_);
+    if (!stats_.components.empty()) {
+        const StorageStats& largest = stats_.components.front();
+        std::format_to(std::back_inserter(line),
+                " largest={}({:.1f}KiB)",
+                largest.type_name,
+                to_kib(largest.bytes));
+    }
+    return line;
+}
+
+void RegistryTelemetry::format_lines() {
+    const EntityStats& entities = stats_.entities;
+
+    lines_.clear();
+    lines_.push_back(std::format(
+            "ECS {} alive {} free  {:.1f} KiB ({:.1f} slack)  +{:.0f}/s "
+            "-{:.0f}/s",
+            entities.alive,
+            entities.free_indices,
+            to_kib(stats_.total_bytes),
+            to_kib(stats_.slack_bytes),
+            created_per_second_,
+            destroyed_per_second_));
+
+    // count / capacity, footprint, sparse fill and dense disorder per type
+    for (const StorageStats& component : stats_.components) {
+        lines_.push_back(std::format(
+                "{:<18.18} {:>6}/{:<6} {:>7.1f} KiB fill {:>3}% "
+                "disorder {:>3}%",
+                component.type_name,
+                component.count,
+                component.capacity,
+                to_kib(component.bytes),
+                to_percent(component.sparse_fill),
+                to_percent(component.disorder)));
+    }
+}
@@ -0,0 +1,55 @@
+//-----------------------------------------------------------------------------
+// src/engine/ecs/registry_telemetry.ixx
+// Periodic Registry::stats() samples with churn rates, formatted for the
+// debug overlay and the log
+//-----------------------------------------------------------------------------
+module;
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+export module Engine.Ecs.Telemetry;
+
+import Engine.Ecs.Registry;
+
+export class RegistryTelemetry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit RegistryTelemetry(
+            Clock::duration interval = std::chrono::seconds(1));
+
+    // Sample the registry if `interval` has passed since the last sample.
+    // Returns true when a new sample was taken.
+    auto update(const Registry& registry, Clock::time_point now) -> bool;
+
+    [[nodiscard]] auto stats() const -> const RegistryStats&;
+    [[nodiscard]] auto samples() const -> uint64_t;
+
+    // Entity churn between the last two samples
+    [[nodiscard]] auto created_per_second() const -> double;
+    [[nodiscard]] auto destroyed_per_second() const -> double;
+
+    // Latest sample as overlay text: a totals line, then one per component
+    [[nodiscard]] auto overlay_lines() const -> std::span<const std::string>;
+
+    // Latest sample as a single log line
+    [[nodiscard]] auto summary() const -> std::string;
+
+private:
+    void format_lines();
+
+    Clock::duration   interval_;
+    Clock::time_point last_sample_{};
+    uint64_t          samples_{0};
+
+    RegistryStats stats_;
+    uint64_t      last_created_{0};
+    uint64_t      last_destroyed_{0};
+    double        created_per_second_{0};
+    double        destroyed_per_second_{0};
+
+    std::vector<std::string> lines_;
+};
@@ -0,0 +1,42 @@
+//-----------------------------------------------------------------------------
+// src/engine/input/input_event.ixx
+// Platform-neutral input events, grouped per simulation tick
+//-----------------------------------------------------------------------------
+module;
+#include <cstdint>
+#include <vector>
+
+export module Engine.Input;
+
+export enum class InputEventType : uint8_t {
+    Quit    = 0,
+    KeyDown = 1,
+    KeyUp   = 2,
+};
+
+export enum class Key : uint32_t {
+    Unknown = 0,
+    Up,
+    Down,
+    Left,
+    Right,
+    Escape,
+    F3,
+};
+
+// Fixed 8-byte, padding-free layout so events can be recorded verbatim
+export struct InputEvent {
+    Key            key;
+    uint16_t       modifiers;
+    InputEventType type;
+    uint8_t        repeat; // 1 if generated by key auto-repeat
+};
+
+static_assert(sizeof(InputEvent) == 8);
+
+// Everything the simulation consumes for one tick: the events that arrived
+// and the seed its random number generators are reset to.
+export struct InputFrame {
+    uint64_t                seed{0};
+    std::vector<InputEvent> events;
+};
@@ -0,0 +1,60 @@
+//-----------------------------------------------------------------------------
+// src/engine/jobs/thread_pool.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+module Engine.Jobs.ThreadPool;
+
+ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) {
+        const size_t hardware = std::thread::hardware_concurrency();
+        thread_count          = hardware > 1 ? hardware - 1 : 1;
+    }
+    workers_.reserve(thread_count);
+    for (size_t worker_idx = 0; worker_idx < thread_count; ++worker_idx) {
+        workers_.emplace_back(
+                [this](const std::stop_token& stop) { worker_loop(stop); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    for (auto& worker : workers_) {
+        worker.request_stop();
+    }
+    workers_.clear(); // joins
+}
+
+void ThreadPool::submit(Task task) {
+    {
+        const std::scoped_lock lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+auto ThreadPool::thread_count() const -> size_t {
+    return workers_.size();
+}
+
+void ThreadPool::worker_loop(const std::stop_token& stop) {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock(mutex_);
+            // Wakes on new work or on stop; the queue is drained before exit
+            wake_.wait(lock, stop, [this] { return !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return; // stop requested and nothing left to do
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
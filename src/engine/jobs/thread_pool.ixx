@@ -0,0 +1,105 @@
+//-----------------------------------------------------------------------------
+// src/engine/jobs/thread_pool.ixx
+// Fixed set of worker threads draining a shared FIFO of tasks
+//-----------------------------------------------------------------------------
+module;
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+export module Engine.Jobs.ThreadPool;
+
+export class ThreadPool {
+public:
+    using Task = std::move_only_function<void()>;
+
+    // 0 picks one worker per hardware thread, minus one for the main thread
+    explicit ThreadPool(size_t thread_count = 0);
+
+    // Joins the workers after they finish every task already submitted
+    ~ThreadPool();
+
+    // non-copyable, non-movable: workers hold a pointer to the pool
+    ThreadPool(const ThreadPool&)                    = delete;
+    auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+    // Queue a task; it runs on some worker, in no particular order relative
+    // to tasks running on other workers.
+    void submit(Task task);
+
+    // Run body(first, last) over [0, count) in chunks of `grain` items spread
+    // across the workers. The caller works through chunks too and returns
+    // once every chunk is done, so bodies may write to disjoint parts of the
+    // caller's data. Call it from outside the pool, never from a task.
+    template <typename Body>
+    void parallel_for(size_t count, size_t grain, Body&& body);
+
+    [[nodiscard]] auto thread_count() const -> size_t;
+
+private:
+    void worker_loop(const std::stop_token& stop);
+
+    std::mutex                  mutex_;
+    std::condition_variable_any wake_;
+    std::deque<Task>            tasks_;
+    std::vector<std::jthread>   workers_; // last member: joined first
+};
+
+//------------------------------------------------------------------------------
+// Definitions of templated methods (must appear in the .ixx interface)
+//------------------------------------------------------------------------------
+template <typename Body>
+void ThreadPool::parallel_for(const size_t count, const size_t grain,
+        Body&& body) {
+    const size_t chunk  = std::max<size_t>(grain, 1);
+    const size_t chunks = (count + chunk - 1) / chunk;
+    if (chunks <= 1 || workers_.empty()) {
+        if (count != 0) {
+            body(size_t{0}, count);
+        }
+        return;
+    }
+
+    // Chunks are claimed from a shared counter. A helper that only starts
+    // after the caller has returned (e.g. queued behind an asset decode)
+    // finds none left, so the counters it touches are shared-owned and the
+    // body is never reached through a stale pointer.
+    struct Progress {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+    };
+    auto       progress = std::make_shared<Progress>();
+    auto*      work     = &body;
+    const auto run      = [progress, work, count, chunk, chunks] {
+        for (size_t idx = progress->next.fetch_add(1, std::memory_order_relaxed);
+                idx < chunks;
+                idx = progress->next.fetch_add(1, std::memory_order_relaxed)) {
+            const size_t first = idx * chunk;
+            (*work)(first, std::min(count, first + chunk));
+            if (progress->done.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+                    chunks) {
+                progress->done.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = std::min(chunks - 1, workers_.size());
+    for (size_t helper = 0; helper < helpers; ++helper) {
+        submit(run);
+    }
+    run();
+
+    // Acquire pairs with each chunk's completion, publishing its writes
+    for (size_t done = progress->done.load(std::memory_order_acquire);
+            done != chunks;
+            done = progress->done.load(std::memory_order_acquire)) {
+        progress->done.wait(done, std::memory_order_acquire);
+    }
+}
@@ -0,0 +1,38 @@
+//-----------------------------------------------------------------------------
+// src/engine/net/loopback_channel.ixx
+// In-process stand-in for a socket: an ordered, lossless packet queue
+//-----------------------------------------------------------------------------
+module;
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+export module Engine.Net.LoopbackChannel;
+
+export class LoopbackChannel {
+public:
+    void send(std::vector<std::byte> packet) {
+        bytes_in_flight_ += packet.size();
+        packets_.push_back(std::move(packet));
+    }
+
+    auto receive() -> std::optional<std::vector<std::byte>> {
+        if (packets_.empty()) {
+            return std::nullopt;
+        }
+        auto packet = std::move(packets_.front());
+        packets_.pop_front();
+        bytes_in_flight_ -= packet.size();
+        return packet;
+    }
+
+    [[nodiscard]] auto bytes_in_flight() const -> size_t {
+        return bytes_in_flight_;
+    }
+
+private:
+    std::deque<std::vector<std::byte>> packets_;
+    size_t                             bytes_in_flight_{0};
+};
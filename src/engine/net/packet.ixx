@@ -0,0 +1,134 @@
+//-----------------------------------------------------------------------------
+// src/engine/net/packet.ixx
+// Byte/bit-level packet encoding: LEB128 varints, packed bit fields, raw bytes
+//-----------------------------------------------------------------------------
+module;
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+export module Engine.Net.Packet;
+
+// Appends to a caller-owned byte buffer. Bit fields are packed LSB-first into
+// whole bytes; call align() (or any byte-level write) to close a bit run.
+export class PacketWriter {
+public:
+    explicit PacketWriter(std::vector<std::byte>& buffer) : buffer_(buffer) {}
+
+    void write_varint(uint64_t value) {
+        align();
+        while (value >= 0x80U) {
+            buffer_.push_back(static_cast<std::byte>((value & 0x7FU) | 0x80U));
+            value >>= 7U;
+        }
+        buffer_.push_back(static_cast<std::byte>(value));
+    }
+
+    void write_bits(const uint32_t value, const uint32_t count) {
+        assert(count <= 32);
+        bit_accumulator_ |= static_cast<uint64_t>(value) << bit_count_;
+        bit_count_ += count;
+        while (bit_count_ >= 8) {
+            buffer_.push_back(static_cast<std::byte>(bit_accumulator_ & 0xFFU));
+            bit_accumulator_ >>= 8U;
+            bit_count_ -= 8;
+        }
+    }
+
+    void write_bytes(const std::span<const std::byte> bytes) {
+        align();
+        buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+    }
+
+    // Flush a partially filled bit byte (zero padded)
+    void align() {
+        if (bit_count_ > 0) {
+            buffer_.push_back(static_cast<std::byte>(bit_accumulator_ & 0xFFU));
+            bit_accumulator_ = 0;
+            bit_count_       = 0;
+        }
+    }
+
+private:
+    std::vector<std::byte>& buffer_;
+    uint64_t                bit_accumulator_{0};
+    uint32_t                bit_count_{0};
+};
+
+// Mirror of PacketWriter. Reads past the end yield zeroes and set a sticky
+// failure flag, so a truncated packet is detected once at the end via ok().
+export class PacketReader {
+public:
+    explicit PacketReader(const std::span<const std::byte> bytes)
+        : bytes_(bytes) {}
+
+    auto read_varint() -> uint64_t {
+        align();
+        uint64_t value = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            if (offset_ >= bytes_.size()) {
+                failed_ = true;
+                return 0;
+            }
+            const auto byte = static_cast<uint64_t>(bytes_[offset_++]);
+            value |= (byte & 0x7FU) << shift;
+            if ((byte & 0x80U) == 0) {
+                return value;
+            }
+        }
+        failed_ = true;
+        return 0;
+    }
+
+    auto read_bits(const uint32_t count) -> uint32_t {
+        assert(count <= 32);
+        while (bit_count_ < count) {
+            if (offset_ >= bytes_.size()) {
+                failed_ = true;
+                return 0;
+            }
+            bit_accumulator_ |= static_cast<uint64_t>(bytes_[offset_++])
+                                << bit_count_;
+            bit_count_ += 8;
+        }
+        const auto mask  = count == 32 ? 0xFFFFFFFFULL : ((1ULL << count) - 1);
+        const auto value = static_cast<uint32_t>(bit_accumulator_ & mask);
+        bit_accumulator_ >>= count;
+        bit_count_ -= count;
+        return value;
+    }
+
+    void read_bytes(const std::span<std::byte> out) {
+        align();
+        if (bytes_.size() - offset_ < out.size()) {
+            failed_ = true;
+            return;
+        }
+        std::memcpy(out.data(), bytes_.data() + offset_, out.size());
+        offset_ += out.size();
+    }
+
+    // Discard the rest of the current bit byte
+    void align() {
+        bit_accumulator_ = 0;
+        bit_count_       = 0;
+    }
+
+    [[nodiscard]] auto ok() const -> bool {
+        return !failed_;
+    }
+
+    [[nodiscard]] auto at_end() const -> bool {
+        return offset_ == bytes_.size();
+    }
+
+private:
+    std::span<const std::byte> bytes_;
+    size_t                     offset_{0};
+    uint64_t                   bit_accumulator_{0};
+    uint32_t                   bit_count_{0};
+    bool                       failed_{false};
+};
@@ -0,0 +1,472 @@
+//-----------------------------------------------------------------------------
+// src/engine/net/replication.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+module Engine.Net.Replication;
+
+import Engine.Rendering.Components.TileMap;
+
+//-----------------------------------------------------------------------------
+// Module-level constants
+//-----------------------------------------------------------------------------
+// Equal cells shorter than this don't split a tile run; a run header costs
+// at least two bytes, so bridging tiny gaps is cheaper.
+static constexpr uint32_t TILE_RUN_MIN_GAP = 3;
+
+// Tile planes are compared against the shadow in blocks of this many cells;
+// only blocks whose bytes differ are examined cell by cell.
+static constexpr size_t TILE_DIFF_BLOCK = 64;
+
+// Upper bound on remote entity indices (and tile counts) accepted from a
+// packet, so a corrupt varint can't make the applier allocate gigabytes.
+static constexpr uint64_t MAX_REMOTE_INDEX = 1ULL << 28U;
+
+//-----------------------------------------------------------------------------
+// Internal Helpers
+//-----------------------------------------------------------------------------
+struct FoundTileMap {
+    Entity         entity;
+    const TileMap* tile_map;
+    uint32_t       version; // last tick the map was written
+};
+
+static auto first_tile_map(const Registry& registry)
+        -> std::optional<FoundTileMap> {
+    const auto* storage = registry.find_storage<TileMap>();
+    if (storage == nullptr || storage->size() == 0) {
+        return std::nullopt;
+    }
+    return FoundTileMap{.entity   = storage->dense_entities().front(),
+            .tile_map = &storage->dense_components().front(),
+            .version  = storage->versions().front()};
+}
+
+static void write_index_deltas(
+        PacketWriter& writer, const std::span<const uint32_t> indices) {
+    writer.write_varint(indices.size());
+    uint32_t previous = 0;
+    for (const auto index : indices) {
+        writer.write_varint(index - previous);
+        previous = index;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// ReplicationSchema
+//-----------------------------------------------------------------------------
+auto ReplicationSchema::types() const
+        -> std::span<const std::unique_ptr<IReplicatedComponent>> {
+    assert(types_.size() <= MAX_TYPES);
+    return types_;
+}
+
+//-----------------------------------------------------------------------------
+// DeltaEncoder
+//-----------------------------------------------------------------------------
+DeltaEncoder::DeltaEncoder(const ReplicationSchema& schema)
+    : schema_(schema), had_component_(schema.types().size()) {}
+
+auto DeltaEncoder::encode(const Registry& registry) -> std::vector<std::byte> {
+    const uint32_t now = registry.current_tick();
+
+    collect_entities(registry);
+    collect_components(registry);
+
+    std::vector<std::byte> packet;
+    PacketWriter           writer(packet);
+    writer.write_varint(now);
+    write_entities(registry, writer);
+    write_components(registry, writer);
+    write_tiles(registry, writer);
+
+    // Ticks before `now` are closed and fully sent. `now` is still open and
+    // may be written again before advance_tick(), so it is re-checked.
+    last_tick_ = now - 1;
+
+    ++stats_.packets;
+    stats_.total_bytes += packet.size();
+    stats_.last_packet_bytes = packet.size();
+    stats_.max_packet_bytes  = std::max(stats_.max_packet_bytes, packet.size());
+    return packet;
+}
+
+auto DeltaEncoder::stats() const -> const EncodeStats& {
+    return stats_;
+}
+
+void DeltaEncoder::collect_entities(const Registry& registry) {
+    const auto generations = registry.entity_manager().generations();
+    const auto count       = generations.size();
+
+    // An index is alive unless it sits on the free list
+    alive_.assign(count, 1);
+    for (const auto free_index : registry.entity_manager().free_indices()) {
+        alive_[free_index] = 0;
+    }
+
+    known_generation_.resize(count, 0);
+    created_.clear();
+    destroyed_.clear();
+    for (uint32_t index = 0; index < count; ++index) {
+        auto& known = known_generation_[index];
+        if (alive_[index] != 0) {
+            if (known != generations[index] + 1) {
+                // Index recycled since the viewer last saw it
+                if (known != 0) {
+                    destroyed_.push_back(index);
+                }
+                created_.push_back(index);
+                known = generations[index] + 1;
+            }
+        } else if (known != 0) {
+            destroyed_.push_back(index);
+            known = 0;
+        }
+    }
+}
+
+void DeltaEncoder::collect_components(const Registry& registry) {
+    const auto entity_count = alive_.size();
+    changed_mask_.resize(entity_count, 0);
+    removed_mask_.resize(entity_count, 0);
+    touched_.clear();
+
+    const auto mark = [&](std::vector<uint32_t>& masks, const uint32_t index,
+                              const uint32_t bit) {
+        if (changed_mask_[index] == 0 && removed_mask_[index] == 0) {
+            touched_.push_back(index);
+        }
+        masks[index] |= bit;
+    };
+
+    const auto types = schema_.types();
+    for (uint32_t type_idx = 0; type_idx < types.size(); ++type_idx) {
+        const uint32_t bit = 1U << type_idx;
+        auto&          had = had_component_[type_idx];
+        had.resize(entity_count, 0);
+
+        // 1) Components stamped since the last packet
+        const auto entities = types[type_idx]->entities(registry);
+        const auto versions = types[type_idx]->versions(registry);
+        for (size_t dense_idx = 0; dense_idx < entities.size(); ++dense_idx) {
+            if (versions[dense_idx] > last_tick_) {
+                mark(changed_mask_, entities[dense_idx].index, bit);
+            }
+        }
+
+        // 2) Components the viewer has that are now gone from live entities
+        const auto sparse = types[type_idx]->sparse(registry);
+        for (uint32_t index = 0; index < entity_count; ++index) {
+            const bool present = index < sparse.size() && sparse[index] >= 0;
+            if (had[index] != 0 && !present && alive_[index] != 0) {
+                mark(removed_mask_, index, bit);
+            }
+            had[index] = present ? 1 : 0;
+        }
+    }
+
+    std::ranges::sort(touched_);
+}
+
+void DeltaEncoder::write_entities(
+        const Registry& registry, PacketWriter& writer) {
+    write_index_deltas(writer, destroyed_);
+
+    const auto generations = registry.entity_manager().generations();
+    writer.write_varint(created_.size());
+    uint32_t previous = 0;
+    for (const auto index : created_) {
+        writer.write_varint(index - previous);
+        writer.write_varint(generations[index]);
+        previous = index;
+    }
+}
+
+void DeltaEncoder::write_components(
+        const Registry& registry, PacketWriter& writer) {
+    const auto types      = schema_.types();
+    const auto type_count = static_cast<uint32_t>(types.size());
+
+    write_index_deltas(writer, touched_);
+
+    // Masks for all entities back to back, so they pack densely
+    for (const auto index : touched_) {
+        writer.write_bits(changed_mask_[index], type_count);
+        writer.write_bits(removed_mask_[index], type_count);
+    }
+    writer.align();
+
+    const auto generations = registry.entity_manager().generations();
+    for (const auto index : touched_) {
+        const Entity entity{.index = index, .generation = generations[index]};
+        for (uint32_t type_idx = 0; type_idx < type_count; ++type_idx) {
+            if ((changed_mask_[index] & (1U << type_idx)) != 0) {
+                types[type_idx]->write(registry, entity, writer);
+            }
+        }
+        changed_mask_[index] = 0;
+        removed_mask_[index] = 0;
+    }
+}
+
+void DeltaEncoder::write_tiles(const Registry& registry, PacketWriter& writer) {
+    const auto found = first_tile_map(registry);
+    if (!found) {
+        writer.write_varint(0);
+        return;
+    }
+    const auto& [entity, tile_map, version] = *found;
+
+    // A new map entity or a resize resets the shadow; the viewer starts from
+    // a zeroed map in both cases too
+    const auto& cells      = tile_map->cells;
+    const bool  new_entity = !tile_entity_ ||
+                            tile_entity_->index != entity.index ||
+                            tile_entity_->generation != entity.generation;
+    const bool  reset      = new_entity || !tile_shadow_.same_size(cells);
+    if (reset) {
+        tile_entity_ = entity;
+        tile_shadow_.resize(cells.cols(), cells.rows());
+    }
+
+    // Find runs of changed cells, bridging short unchanged gaps. A map not
+    // written since the last packet has none, so skip the diff entirely.
+    tile_runs_.clear();
+    const bool written = reset || version > last_tick_;
+    if (written) {
+        diff_tiles(cells);
+    }
+    const auto scan_end =
+            written ? static_cast<uint32_t>(cells.cell_count()) : 0U;
+    const auto differs = [&](const uint32_t cell) {
+        return tile_changed_[cell] != 0;
+    };
+    uint32_t cell = 0;
+    while (cell < scan_end) {
+        if (!differs(cell)) {
+            ++cell;
+            continue;
+        }
+        const uint32_t start    = cell;
+        uint32_t       run_end  = cell + 1;
+        uint32_t       equal    = 0;
+        for (cell = run_end; cell < scan_end && equal < TILE_RUN_MIN_GAP;
+                ++cell) {
+            if (differs(cell)) {
+                run_end = cell + 1;
+                equal   = 0;
+            } else {
+                ++equal;
+            }
+        }
+        tile_runs_.emplace_back(start, run_end - start);
+        cell = run_end;
+    }
+
+    writer.write_varint(static_cast<uint64_t>(entity.index) + 1);
+    writer.write_varint(cells.cols());
+    writer.write_varint(cells.rows());
+    writer.write_varint(tile_runs_.size());
+    uint32_t previous_end = 0;
+    for (const auto& [start, length] : tile_runs_) {
+        writer.write_varint(start - previous_end);
+        writer.write_varint(length);
+        for (size_t plane_idx = 0; plane_idx < CONSOLE_PLANE_COUNT; ++plane_idx) {
+            const auto plane = cells.plane(static_cast<ConsolePlane>(plane_idx));
+            writer.write_bytes(std::as_bytes(plane.subspan(start, length)));
+        }
+        tile_shadow_.copy_cells(cells, start, length);
+        previous_end = start + length;
+    }
+}
+
+void DeltaEncoder::diff_tiles(const ConsoleBuffer& cells) {
+    // Plane by plane over the SoA layout: memcmp rules out unchanged blocks,
+    // then a byte loop marks the cells that differ in any plane
+    const size_t cell_count = cells.cell_count();
+    tile_changed_.assign(cell_count, 0);
+    for (size_t plane_idx = 0; plane_idx < CONSOLE_PLANE_COUNT; ++plane_idx) {
+        const auto plane_id = static_cast<ConsolePlane>(plane_idx);
+        const auto current  = cells.plane(plane_id);
+        const auto shadow   = std::as_const(tile_shadow_).plane(plane_id);
+        for (size_t first = 0; first < cell_count; first += TILE_DIFF_BLOCK) {
+            const size_t count = std::min(TILE_DIFF_BLOCK, cell_count - first);
+            if (std::memcmp(current.data() + first, shadow.data() + first, count) == 0) {
+                continue;
+            }
+            for (size_t cell = first; cell < first + count; ++cell) {
+                tile_changed_[cell] |= static_cast<uint8_t>(current[cell] != shadow[cell]);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// DeltaApplier
+//-----------------------------------------------------------------------------
+DeltaApplier::DeltaApplier(const ReplicationSchema& schema) : schema_(schema) {}
+
+auto DeltaApplier::apply(
+        const std::span<const std::byte> packet, Registry& registry) -> bool {
+    const auto start = std::chrono::steady_clock::now();
+
+    PacketReader reader(packet);
+    reader.read_varint(); // authoritative tick, informational
+    const bool ok = apply_entities(reader, registry) &&
+                    apply_components(reader, registry) &&
+                    apply_tiles(reader, registry) && reader.ok() &&
+                    reader.at_end();
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start);
+    const auto elapsed_ns = static_cast<uint64_t>(elapsed.count());
+    ++stats_.packets;
+    stats_.total_apply_ns += elapsed_ns;
+    stats_.last_apply_ns = elapsed_ns;
+    stats_.max_apply_ns  = std::max(stats_.max_apply_ns, elapsed_ns);
+    return ok;
+}
+
+auto DeltaApplier::local_entity(const uint32_t remote_index) const
+        -> std::optional<Entity> {
+    if (remote_index >= mapped_.size() || mapped_[remote_index] == 0) {
+        return std::nullopt;
+    }
+    return local_[remote_index];
+}
+
+auto DeltaApplier::stats() const -> const ApplyStats& {
+    return stats_;
+}
+
+auto DeltaApplier::apply_entities(PacketReader& reader, Registry& registry)
+        -> bool {
+    // 1) Destroyed
+    const auto destroyed_count = reader.read_varint();
+    uint64_t   index           = 0;
+    for (uint64_t i = 0; i < destroyed_count && reader.ok(); ++i) {
+        index += reader.read_varint();
+        if (index < mapped_.size() && mapped_[index] != 0) {
+            registry.destroy_entity(local_[index]);
+            mapped_[index] = 0;
+        }
+    }
+
+    // 2) Created (generation is carried for debugging; local ids differ)
+    const auto created_count = reader.read_varint();
+    index                    = 0;
+    for (uint64_t i = 0; i < created_count && reader.ok(); ++i) {
+        index += reader.read_varint();
+        reader.read_varint();
+        if (index >= MAX_REMOTE_INDEX) {
+            return false;
+        }
+        if (index >= mapped_.size()) {
+            local_.resize(index + 1);
+            mapped_.resize(index + 1, 0);
+        }
+        if (mapped_[index] != 0) {
+            registry.destroy_entity(local_[index]);
+        }
+        local_[index]  = registry.create_entity();
+        mapped_[index] = 1;
+    }
+    return reader.ok();
+}
+
+auto DeltaApplier::apply_components(PacketReader& reader, Registry& registry)
+        -> bool {
+    const auto types      = schema_.types();
+    const auto type_count = static_cast<uint32_t>(types.size());
+
+    const auto touched_count = reader.read_varint();
+    if (touched_count >= MAX_REMOTE_INDEX) {
+        return false;
+    }
+    indices_.clear();
+    uint64_t index = 0;
+    for (uint64_t i = 0; i < touched_count && reader.ok(); ++i) {
+        index += reader.read_varint();
+        if (index >= mapped_.size() || mapped_[index] == 0) {
+            return false;
+        }
+        indices_.push_back(static_cast<uint32_t>(index));
+    }
+
+    masks_.clear();
+    for (size_t i = 0; i < indices_.size(); ++i) {
+        masks_.push_back(reader.read_bits(type_count)); // changed
+        masks_.push_back(reader.read_bits(type_count)); // removed
+    }
+    reader.align();
+
+    for (size_t i = 0; i < indices_.size() && reader.ok(); ++i) {
+        const auto entity  = local_[indices_[i]];
+        const auto changed = masks_[2 * i];
+        const auto removed = masks_[(2 * i) + 1];
+        for (uint32_t type_idx = 0; type_idx < type_count; ++type_idx) {
+            if ((changed & (1U << type_idx)) != 0) {
+                types[type_idx]->apply(registry, entity, reader);
+            }
+            if ((removed & (1U << type_idx)) != 0) {
+                types[type_idx]->remove(registry, entity);
+            }
+        }
+    }
+    return reader.ok();
+}
+
+auto DeltaApplier::apply_tiles(PacketReader& reader, Registry& registry)
+        -> bool {
+    const auto entity_tag = reader.read_varint();
+    if (entity_tag == 0) {
+        return reader.ok();
+    }
+    const auto index     = entity_tag - 1;
+    const auto cols      = static_cast<uint32_t>(reader.read_varint());
+    const auto rows      = static_cast<uint32_t>(reader.read_varint());
+    const auto run_count = reader.read_varint();
+    if (!reader.ok() || index >= mapped_.size() || mapped_[index] == 0 ||
+            static_cast<uint64_t>(cols) * rows >= MAX_REMOTE_INDEX) {
+        return false;
+    }
+
+    // Mirror the encoder's shadow reset on first sight or resize
+    const auto entity = local_[index];
+    if (!registry.has_component<TileMap>(entity)) {
+        registry.add_component<TileMap>(entity);
+    }
+    auto& cells = registry.get_component<TileMap>(entity).cells;
+    if (cells.cols() != cols || cells.rows() != rows) {
+        cells.resize(cols, rows);
+    }
+
+    const size_t cell_count = cells.cell_count();
+    size_t       position   = 0;
+    for (uint64_t i = 0; i < run_count && reader.ok(); ++i) {
+        position += reader.read_varint();
+        const auto length = reader.read_varint();
+        if (position > cell_count || cell_count - position < length) {
+            return false;
+        }
+        for (size_t plane_idx = 0; plane_idx < CONSOLE_PLANE_COUNT; ++plane_idx) {
+            const auto plane = cells.plane(static_cast<ConsolePlane>(plane_idx));
+            reader.read_bytes(
+                    std::as_writable_bytes(plane.subspan(position, length)));
+        }
+        position += length;
+    }
+    return reader.ok();
+}
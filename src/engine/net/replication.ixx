@@ -0,0 +1,227 @@
+//-----------------------------------------------------------------------------
+// src/engine/net/replication.ixx
+// Tick-to-tick delta replication of a Registry from an authoritative instance
+// to viewers
+//-----------------------------------------------------------------------------
+module;
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+export module Engine.Net.Replication;
+
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+import Engine.Net.Packet;
+import Engine.Rendering.Console;
+
+//-----------------------------------------------------------------------------
+// Schema: which component types replicate, in wire order. Both ends must
+// register the same types in the same order.
+//-----------------------------------------------------------------------------
+export struct IReplicatedComponent {
+    virtual ~IReplicatedComponent() = default;
+
+    // Views of the underlying ComponentStorage (empty if missing)
+    virtual auto entities(const Registry& registry)
+            -> std::span<const Entity> = 0;
+    virtual auto versions(const Registry& registry)
+            -> std::span<const uint32_t> = 0;
+    virtual auto sparse(const Registry& registry)
+            -> std::span<const int32_t> = 0;
+
+    // Serialize one entity's component / apply it on the receiving side
+    virtual void write(const Registry& registry, Entity entity,
+                       PacketWriter& writer)                    = 0;
+    virtual void apply(Registry& registry, Entity entity,
+                       PacketReader& reader)                    = 0;
+    virtual void remove(Registry& registry, Entity entity)      = 0;
+};
+
+export template <typename Component>
+    requires std::is_trivially_copyable_v<Component>
+class ReplicatedComponent final : public IReplicatedComponent {
+public:
+    auto entities(const Registry& registry)
+            -> std::span<const Entity> override {
+        const auto* storage = registry.find_storage<Component>();
+        return storage != nullptr ? storage->dense_entities()
+                                  : std::span<const Entity>{};
+    }
+
+    auto versions(const Registry& registry)
+            -> std::span<const uint32_t> override {
+        const auto* storage = registry.find_storage<Component>();
+        return storage != nullptr ? storage->versions()
+                                  : std::span<const uint32_t>{};
+    }
+
+    auto sparse(const Registry& registry)
+            -> std::span<const int32_t> override {
+        const auto* storage = registry.find_storage<Component>();
+        return storage != nullptr ? storage->sparse_indices()
+                                  : std::span<const int32_t>{};
+    }
+
+    void write(const Registry& registry, const Entity entity,
+               PacketWriter& writer) override {
+        const auto& component = registry.get_component<Component>(entity);
+        writer.write_bytes(std::as_bytes(std::span(&component, 1)));
+    }
+
+    void apply(Registry& registry, const Entity entity,
+               PacketReader& reader) override {
+        Component value{};
+        reader.read_bytes(std::as_writable_bytes(std::span(&value, 1)));
+        if (registry.has_component<Component>(entity)) {
+            registry.patch<Component>(entity) = value;
+        } else {
+            registry.add_component<Component>(entity, value);
+        }
+    }
+
+    void remove(Registry& registry, const Entity entity) override {
+        registry.remove_component<Component>(entity);
+    }
+};
+
+export class ReplicationSchema {
+public:
+    // Component presence/change masks are packed into 32 bits
+    static constexpr size_t MAX_TYPES = 32;
+
+    template <typename Component> void add();
+
+    [[nodiscard]] auto types() const
+            -> std::span<const std::unique_ptr<IReplicatedComponent>>;
+
+private:
+    std::vector<std::unique_ptr<IReplicatedComponent>> types_;
+};
+
+//-----------------------------------------------------------------------------
+// Telemetry
+//-----------------------------------------------------------------------------
+export struct EncodeStats {
+    uint64_t packets{0};
+    uint64_t total_bytes{0};
+    size_t   last_packet_bytes{0};
+    size_t   max_packet_bytes{0};
+};
+
+export struct ApplyStats {
+    uint64_t packets{0};
+    uint64_t total_apply_ns{0};
+    uint64_t last_apply_ns{0};
+    uint64_t max_apply_ns{0};
+};
+
+//-----------------------------------------------------------------------------
+// Encoder (authoritative side)
+//-----------------------------------------------------------------------------
+// Packet layout (all integers LEB128 varints unless noted):
+//   tick
+//   destroyed count, then entity index deltas
+//   created count,   then (entity index delta, generation) pairs
+//   changed count,   then entity index deltas,
+//                    then bit-packed (changed mask, removed mask) per entity,
+//                    then raw component bytes in mask order
+//   tile map entity index + 1 (0 = none), cols, rows, run count,
+//                    then (gap, length, raw cells) per run, the cells sent
+//                    as `length` bytes of each console plane in order
+//
+// Each encoder tracks what its viewer already has, so run one per viewer.
+// A fresh encoder sends a full state on its first encode(). Replacing the
+// Registry wholesale (e.g. a snapshot load) needs a fresh encoder too.
+//
+// Encoders never tick the world: the game loop calls advance_tick() once per
+// simulation step, then encodes for every viewer.
+//-----------------------------------------------------------------------------
+export class DeltaEncoder {
+public:
+    explicit DeltaEncoder(const ReplicationSchema& schema);
+
+    // Diff the registry against what this viewer has and return the packet.
+    // Changes are found through component versions: any mutable access
+    // (get_component, patch, mutable for_each) counts as a change. Only
+    // closed ticks are marked as sent; writes stamped in the still-open tick
+    // go out again in the next packet, so a write made between two viewers'
+    // encode() calls reaches both, whatever the call order.
+    auto encode(const Registry& registry) -> std::vector<std::byte>;
+
+    [[nodiscard]] auto stats() const -> const EncodeStats&;
+
+private:
+    void collect_entities(const Registry& registry);
+    void collect_components(const Registry& registry);
+    void write_entities(const Registry& registry, PacketWriter& writer);
+    void write_components(const Registry& registry, PacketWriter& writer);
+    void write_tiles(const Registry& registry, PacketWriter& writer);
+    void diff_tiles(const ConsoleBuffer& cells);
+
+    const ReplicationSchema& schema_;
+    uint32_t                 last_tick_{0}; // newest closed tick sent
+
+    // What the viewer knows, by entity index
+    std::vector<uint32_t>             known_generation_; // generation + 1
+    std::vector<std::vector<uint8_t>> had_component_;    // per schema type
+    ConsoleBuffer                     tile_shadow_;
+    std::optional<Entity>             tile_entity_;
+
+    // Per-encode scratch, kept to avoid reallocating every tick
+    std::vector<uint8_t>                       alive_;
+    std::vector<uint32_t>                      created_;
+    std::vector<uint32_t>                      destroyed_;
+    std::vector<uint32_t>                      touched_;
+    std::vector<uint32_t>                      changed_mask_;
+    std::vector<uint32_t>                      removed_mask_;
+    std::vector<std::pair<uint32_t, uint32_t>> tile_runs_;
+    std::vector<uint8_t>                       tile_changed_; // per cell
+
+    EncodeStats stats_;
+};
+
+//-----------------------------------------------------------------------------
+// Applier (viewer side)
+//-----------------------------------------------------------------------------
+export class DeltaApplier {
+public:
+    explicit DeltaApplier(const ReplicationSchema& schema);
+
+    // Apply one packet; returns false if it was malformed (the registry may
+    // then be partially updated and should be resynced).
+    auto apply(std::span<const std::byte> packet, Registry& registry) -> bool;
+
+    // Local entity mirroring a remote entity index, if any
+    [[nodiscard]] auto local_entity(uint32_t remote_index) const
+            -> std::optional<Entity>;
+
+    [[nodiscard]] auto stats() const -> const ApplyStats&;
+
+private:
+    auto apply_entities(PacketReader& reader, Registry& registry) -> bool;
+    auto apply_components(PacketReader& reader, Registry& registry) -> bool;
+    auto apply_tiles(PacketReader& reader, Registry& registry) -> bool;
+
+    const ReplicationSchema& schema_;
+
+    std::vector<Entity>  local_;  // by remote entity index
+    std::vector<uint8_t> mapped_; // whether local_[i] is valid
+
+    std::vector<uint32_t> indices_; // scratch
+    std::vector<uint32_t> masks_;   // scratch
+
+    ApplyStats stats_;
+};
+
+//------------------------------------------------------------------------------
+// Definitions of templated methods (must appear in the .ixx interface)
+//------------------------------------------------------------------------------
+template <typename Component> void ReplicationSchema::add() {
+    types_.push_back(std::make_unique<ReplicatedComponent<Component>>());
+}
@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// src/engine/platform/os/mapped_file.cpp
+//-----------------------------------------------------------------------------
+module;
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <optional>
+#include <print>
+#include <span>
+#include <string>
+#include <utility>
+
+module Engine.Platform.MappedFile;
+
+//-----------------------------------------------------------------------------
+// Factory and Special Members
+//-----------------------------------------------------------------------------
+auto MappedFile::open(const std::string& path) -> std::optional<MappedFile> {
+    MappedFile instance;
+
+#if defined(_WIN32)
+    instance.file_handle_ = CreateFileA(path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr);
+    if (instance.file_handle_ == INVALID_HANDLE_VALUE) {
+        instance.file_handle_ = nullptr;
+        std::println(stderr, "Failed to open '{}'", path);
+        return std::nullopt;
+    }
+
+    LARGE_INTEGER file_size{};
+    if (GetFileSizeEx(instance.file_handle_, &file_size) == 0 ||
+            file_size.QuadPart == 0) {
+        std::println(stderr, "Failed to size '{}'", path);
+        return std::nullopt;
+    }
+    instance.size_ = static_cast<std::size_t>(file_size.QuadPart);
+
+    instance.mapping_handle_ = CreateFileMappingA(
+            instance.file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (instance.mapping_handle_ == nullptr) {
+        std::println(stderr, "Failed to map '{}'", path);
+        return std::nullopt;
+    }
+
+    instance.data_ = static_cast<const std::byte*>(
+            MapViewOfFile(instance.mapping_handle_, FILE_MAP_READ, 0, 0, 0));
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        std::println(stderr, "Failed to open '{}'", path);
+        return std::nullopt;
+    }
+
+    struct stat info {};
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        std::println(stderr, "Failed to size '{}'", path);
+        close(file);
+        return std::nullopt;
+    }
+    instance.size_ = static_cast<std::size_t>(info.st_size);
+
+    void* address = mmap(nullptr, instance.size_, PROT_READ, MAP_PRIVATE, file, 0);
+    // The mapping keeps its own reference to the file
+    close(file);
+    if (address == MAP_FAILED) {
+        std::println(stderr, "Failed to map '{}'", path);
+        return std::nullopt;
+    }
+
+    // We read everything exactly once; let the kernel read ahead
+    madvise(address, instance.size_, MADV_WILLNEED);
+    instance.data_ = static_cast<const std::byte*>(address);
+#endif
+
+    if (instance.data_ == nullptr) {
+        std::println(stderr, "Failed to map '{}'", path);
+        return std::nullopt;
+    }
+    return std::make_optional<MappedFile>(std::move(instance));
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_), size_(other.size_)
+#if defined(_WIN32)
+      ,
+      file_handle_(other.file_handle_), mapping_handle_(other.mapping_handle_)
+#endif
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+#if defined(_WIN32)
+    other.file_handle_    = nullptr;
+    other.mapping_handle_ = nullptr;
+#endif
+}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+    if (this != &other) {
+        cleanup();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#if defined(_WIN32)
+        file_handle_    = std::exchange(other.file_handle_, nullptr);
+        mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    cleanup();
+}
+
+//-----------------------------------------------------------------------------
+// Access & Cleanup
+//-----------------------------------------------------------------------------
+auto MappedFile::bytes() const -> std::span<const std::byte> {
+    return {data_, size_};
+}
+
+void MappedFile::cleanup() {
+#if defined(_WIN32)
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_ != nullptr) {
+        CloseHandle(mapping_handle_);
+        mapping_handle_ = nullptr;
+    }
+    if (file_handle_ != nullptr) {
+        CloseHandle(file_handle_);
+        file_handle_ = nullptr;
+    }
+#else
+    if (data_ != nullptr) {
+        munmap(const_cast<std::byte*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
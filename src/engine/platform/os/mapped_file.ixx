@@ -0,0 +1,40 @@
+//-----------------------------------------------------------------------------
+// src/engine/platform/os/mapped_file.ixx
+// Read-only memory mapping of a whole file
+//-----------------------------------------------------------------------------
+module;
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+export module Engine.Platform.MappedFile;
+
+export class MappedFile {
+public:
+    // Factory: maps the file read-only, or returns nullopt on failure.
+    static auto open(const std::string& path) -> std::optional<MappedFile>;
+
+    // non-copyable, movable
+    MappedFile(const MappedFile&)                    = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+    ~MappedFile();
+
+    [[nodiscard]] auto bytes() const -> std::span<const std::byte>;
+
+    // Unmap and close (safe to call multiple times).
+    void cleanup();
+
+private:
+    // private constructor used by factory
+    MappedFile() = default;
+
+    const std::byte* data_{nullptr};
+    std::size_t      size_{0};
+#if defined(_WIN32)
+    void* file_handle_{nullptr};
+    void* mapping_handle_{nullptr};
+#endif
+};
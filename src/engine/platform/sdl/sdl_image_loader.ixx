@@ -2,45 +2,79 @@ module;
 #include <SDL3/SDL_opengl.h>
 #include <SDL3/SDL_surface.h>
 #include <SDL3_image/SDL_image.h>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <print>
+#include <span>
 #include <string>
-#include <vector>
 
 export module Engine.Platform.Sdl:ImageLoader;
 
+struct SurfaceDeleter {
+    void operator()(SDL_Surface* surface) const {
+        SDL_DestroySurface(surface);
+    }
+};
+
+// Decoded image. Owns the SDL surface it was decoded into, so the pixels are
+// handed to GL straight from the decoder's buffer without another copy.
 export struct ImageData {
     uint32_t width{};
     uint32_t height{};
-    GLenum   format{};    // GL_RGB or GL_RGBA
-    std::vector<uint8_t> pixels;
+    GLenum   format{};         // GL_RGB or GL_RGBA
+    uint32_t bytes_per_pixel{};
+    uint32_t pitch{};          // bytes per row, multiple of 4, may include padding
+
+    std::unique_ptr<SDL_Surface, SurfaceDeleter> surface;
+
+    [[nodiscard]] auto pixels() const -> std::span<const std::byte> {
+        return {static_cast<const std::byte*>(surface->pixels),
+                static_cast<size_t>(pitch) * height};
+    }
+
+    // Pixels of rows [first_row, first_row + row_count)
+    [[nodiscard]] auto rows(const uint32_t first_row,
+                            const uint32_t row_count) const
+            -> std::span<const std::byte> {
+        return pixels().subspan(static_cast<size_t>(pitch) * first_row,
+                                static_cast<size_t>(pitch) * row_count);
+    }
 };
 
-export auto load_image(const std::string& path) {
+// Decode an image file. Safe to call from worker threads: touches no GL or
+// window state.
+export auto load_image(const std::string& path) -> std::optional<ImageData> {
     SDL_Surface* surface = IMG_Load(path.c_str());
     if (surface == nullptr) {
         std::println(stderr, "Failed to load image: {}", std::string(SDL_GetError()));
-        return ImageData{};
+        return std::nullopt;
     }
-    ImageData image_data;
-    image_data.width  = surface->w;
-    image_data.height = surface->h;
-
-    // Determine GL format
-    if (const uint32_t bpp = SDL_BYTESPERPIXEL(surface->format); bpp == 4) {
-        image_data.format = GL_RGBA;
-    } else if (bpp == 3) {
-        image_data.format = GL_RGB;
-    } else {
-        std::println(stderr, "Unsupported image format: {}", path);
+
+    // GL consumes byte-ordered RGB/RGBA directly; anything else (paletted,
+    // BGRA, ...) is converted once here, on the decoding thread. So are rows
+    // packed tighter than 4 bytes: the uploader relies on that alignment to
+    // describe RGB row padding to GL.
+    if ((surface->format != SDL_PIXELFORMAT_RGBA32 &&
+         surface->format != SDL_PIXELFORMAT_RGB24) ||
+        surface->pitch % 4 != 0) {
+        SDL_Surface* converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
         SDL_DestroySurface(surface);
-        return ImageData{};
+        if (converted == nullptr) {
+            std::println(stderr, "Unsupported image format: {}", path);
+            return std::nullopt;
+        }
+        surface = converted;
     }
 
-    const size_t byte_count = static_cast<size_t>(surface->pitch) * surface->h;
-    image_data.pixels.resize(byte_count);
-    memcpy(image_data.pixels.data(), surface->pixels, byte_count);
-    SDL_DestroySurface(surface);
+    ImageData image_data;
+    image_data.width           = static_cast<uint32_t>(surface->w);
+    image_data.height          = static_cast<uint32_t>(surface->h);
+    image_data.bytes_per_pixel = SDL_BYTESPERPIXEL(surface->format);
+    image_data.format          = image_data.bytes_per_pixel == 4 ? GL_RGBA : GL_RGB;
+    image_data.pitch           = static_cast<uint32_t>(surface->pitch);
+    image_data.surface.reset(surface);
 
     return image_data;
 }
\ No newline at end of file
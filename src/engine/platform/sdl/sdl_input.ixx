@@ -0,0 +1,62 @@
+module;
+#include <SDL3/SDL_events.h>
+#include <optional>
+#include <vector>
+
+export module Engine.Platform.Sdl:Input;
+
+import Engine.Input;
+
+auto translate_key(const SDL_Keycode keycode) -> Key {
+    switch (keycode) {
+    case SDLK_UP:
+        return Key::Up;
+    case SDLK_DOWN:
+        return Key::Down;
+    case SDLK_LEFT:
+        return Key::Left;
+    case SDLK_RIGHT:
+        return Key::Right;
+    case SDLK_ESCAPE:
+        return Key::Escape;
+    case SDLK_F3:
+        return Key::F3;
+    default:
+        return Key::Unknown;
+    }
+}
+
+auto translate_event(const SDL_Event& event) -> std::optional<InputEvent> {
+    switch (event.type) {
+    case SDL_EVENT_QUIT:
+        return InputEvent{.key = Key::Unknown,
+                .modifiers     = 0,
+                .type          = InputEventType::Quit,
+                .repeat        = 0};
+    case SDL_EVENT_KEY_DOWN:
+    case SDL_EVENT_KEY_UP: {
+        const auto key = translate_key(event.key.key);
+        if (key == Key::Unknown) {
+            return std::nullopt;
+        }
+        return InputEvent{.key = key,
+                .modifiers     = event.key.mod,
+                .type          = event.type == SDL_EVENT_KEY_DOWN
+                                         ? InputEventType::KeyDown
+                                         : InputEventType::KeyUp,
+                .repeat        = static_cast<uint8_t>(event.key.repeat ? 1 : 0)};
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+// Drain the SDL event queue into platform-neutral events
+export void poll_input_events(std::vector<InputEvent>& out) {
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        if (const auto input = translate_event(event)) {
+            out.push_back(*input);
+        }
+    }
+}
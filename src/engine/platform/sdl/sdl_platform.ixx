@@ -1,4 +1,5 @@
 export module Engine.Platform.Sdl;
 
 export import :GlGraphicsContext;
-export import :ImageLoader;
\ No newline at end of file
+export import :ImageLoader;
+export import :Input;
\ No newline at end of file
@@ -3,8 +3,11 @@
 //-----------------------------------------------------------------------------
 export module Engine.Rendering.Components.GlyphRenderable;
 
+import Engine.Core;
+
 export struct GlyphRenderable
 {
-    char glyph;      // ASCII character (e.g. '@', '#', etc.)
-    // could also store color, tint, or UV‐offset here if desired
+    char glyph;                // ASCII character (e.g. '@', '#', etc.)
+    Rgb8 color{255, 255, 255}; // foreground tint
+    // could also store a UV‐offset here if desired
 };
\ No newline at end of file
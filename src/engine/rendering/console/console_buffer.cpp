@@ -0,0 +1,352 @@
+//-----------------------------------------------------------------------------
+// src/engine/rendering/console/console_buffer.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CONSOLE_USE_SSE2 1
+#endif
+
+// pshufb is not part of baseline x86-64; it is only used when the build
+// targets it (e.g. -march=x86-64-v2 or /arch:AVX). The default build sets no
+// such flag, so this path is compiled out and translate_cells runs the
+// scalar lookup.
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define CONSOLE_USE_SSSE3 1
+#endif
+
+module Engine.Rendering.Console;
+
+//-----------------------------------------------------------------------------
+// Byte kernels. Each processes [0, count) and must give bit-identical results
+// on the SIMD and scalar paths (replays and replication hash these bytes).
+//-----------------------------------------------------------------------------
+
+// dst[i] = mask[i] ? src[i] : dst[i], where mask bytes are 0x00 or 0xFF
+static void select_bytes(uint8_t* dst, const uint8_t* src, const uint8_t* mask,
+        const size_t count) {
+    size_t idx = 0;
+#ifdef CONSOLE_USE_SSE2
+    for (; idx + 16 <= count; idx += 16) {
+        const __m128i keep = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(mask + idx));
+        const __m128i over = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + idx));
+        const __m128i base =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + idx));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + idx),
+                _mm_or_si128(_mm_and_si128(keep, over),
+                        _mm_andnot_si128(keep, base)));
+    }
+#endif
+    for (; idx < count; ++idx) {
+        dst[idx] = static_cast<uint8_t>(
+                (src[idx] & mask[idx]) | (dst[idx] & ~mask[idx]));
+    }
+}
+
+// glyph_mask[i] = glyph[i] != 0; bg_mask[i] = glyph_mask[i] && (flags[i] & bit)
+static void build_masks(const uint8_t* glyphs, const uint8_t* flags,
+        uint8_t* glyph_mask, uint8_t* bg_mask, const size_t count) {
+    size_t idx = 0;
+#ifdef CONSOLE_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bit  = _mm_set1_epi8(static_cast<char>(CELL_PAINTS_BACKGROUND));
+    for (; idx + 16 <= count; idx += 16) {
+        const __m128i glyph = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(glyphs + idx));
+        const __m128i flag = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(flags + idx));
+        const __m128i empty    = _mm_cmpeq_epi8(glyph, zero);
+        const __m128i no_paint = _mm_cmpeq_epi8(_mm_and_si128(flag, bit), zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(glyph_mask + idx),
+                _mm_andnot_si128(empty, _mm_set1_epi8(-1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bg_mask + idx),
+                _mm_andnot_si128(_mm_or_si128(empty, no_paint),
+                        _mm_set1_epi8(-1)));
+    }
+#endif
+    for (; idx < count; ++idx) {
+        const bool has_glyph = glyphs[idx] != 0;
+        glyph_mask[idx]      = has_glyph ? 0xFF : 0x00;
+        bg_mask[idx] = has_glyph && (flags[idx] & CELL_PAINTS_BACKGROUND) != 0
+                               ? 0xFF
+                               : 0x00;
+    }
+}
+
+// values[i] = round(values[i] * light[i] / 255)
+static void scale_bytes(
+        uint8_t* values, const uint8_t* light, const size_t count) {
+    size_t idx = 0;
+#ifdef CONSOLE_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i half = _mm_set1_epi16(128);
+    const auto    scale_half = [&](const __m128i value, const __m128i level) {
+        // t = v * l + 128; (t + (t >> 8)) >> 8 is exact rounding of v*l/255
+        const __m128i product = _mm_add_epi16(_mm_mullo_epi16(value, level), half);
+        return _mm_srli_epi16(
+                _mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+    };
+    for (; idx + 16 <= count; idx += 16) {
+        const __m128i value = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(values + idx));
+        const __m128i level = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(light + idx));
+        const __m128i low  = scale_half(_mm_unpacklo_epi8(value, zero),
+                _mm_unpacklo_epi8(level, zero));
+        const __m128i high = scale_half(_mm_unpackhi_epi8(value, zero),
+                _mm_unpackhi_epi8(level, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + idx),
+                _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; idx < count; ++idx) {
+        const uint32_t product = (static_cast<uint32_t>(values[idx]) * light[idx]) + 128U;
+        values[idx]            = static_cast<uint8_t>((product + (product >> 8U)) >> 8U);
+    }
+}
+
+// dst[i] = table[keys[i]]
+static void lookup_bytes(uint8_t* dst, const uint8_t* keys,
+        const std::array<uint8_t, 256>& table, const size_t count) {
+    size_t idx = 0;
+#ifdef CONSOLE_USE_SSSE3
+    if (count >= 16) {
+        // pshufb looks up 16 entries at a time, so the table is split into
+        // 16 blocks by the key's high nibble. The most common uniform block
+        // value becomes the starting result; only blocks that differ from
+        // it cost a shuffle (or a broadcast) per 16 keys. Compact enums
+        // like TileType touch one or two blocks.
+        std::array<uint32_t, 256> uniform_votes{};
+        std::array<bool, 16>      uniform{};
+        for (size_t block = 0; block < 16; ++block) {
+            const auto* entries = table.data() + (block * 16);
+            uniform[block]      = std::all_of(entries,
+                    entries + 16,
+                    [&](const uint8_t entry) { return entry == entries[0]; });
+            if (uniform[block]) {
+                ++uniform_votes[entries[0]];
+            }
+        }
+        const auto fill = static_cast<uint8_t>(
+                std::ranges::max_element(uniform_votes) - uniform_votes.begin());
+
+        std::array<__m128i, 16> block_tables{};
+        std::array<__m128i, 16> block_ids{};
+        size_t                  active = 0;
+        for (size_t block = 0; block < 16; ++block) {
+            if (uniform[block] && table[block * 16] == fill) {
+                continue;
+            }
+            block_tables[active] = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(table.data() + (block * 16)));
+            block_ids[active] = _mm_set1_epi8(static_cast<char>(block));
+            ++active;
+        }
+
+        const __m128i low_nibble = _mm_set1_epi8(0x0F);
+        const __m128i fill_value = _mm_set1_epi8(static_cast<char>(fill));
+        for (; idx + 16 <= count; idx += 16) {
+            const __m128i key = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(keys + idx));
+            const __m128i low  = _mm_and_si128(key, low_nibble);
+            const __m128i high = _mm_and_si128(_mm_srli_epi16(key, 4), low_nibble);
+            __m128i       result = fill_value;
+            for (size_t block = 0; block < active; ++block) {
+                const __m128i hit   = _mm_cmpeq_epi8(high, block_ids[block]);
+                const __m128i value = _mm_shuffle_epi8(block_tables[block], low);
+                result = _mm_or_si128(_mm_and_si128(hit, value),
+                        _mm_andnot_si128(hit, result));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + idx), result);
+        }
+    }
+#endif
+    for (; idx < count; ++idx) {
+        dst[idx] = table[keys[idx]];
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Construction & Access
+//-----------------------------------------------------------------------------
+ConsoleBuffer::ConsoleBuffer(const uint32_t cols, const uint32_t rows) {
+    resize(cols, rows);
+}
+
+void ConsoleBuffer::resize(const uint32_t cols, const uint32_t rows) {
+    cols_ = cols;
+    rows_ = rows;
+    planes_.assign(CONSOLE_PLANE_COUNT * cell_count(), 0);
+}
+
+auto ConsoleBuffer::cols() const -> uint32_t {
+    return cols_;
+}
+
+auto ConsoleBuffer::rows() const -> uint32_t {
+    return rows_;
+}
+
+auto ConsoleBuffer::cell_count() const -> size_t {
+    return static_cast<size_t>(cols_) * rows_;
+}
+
+auto ConsoleBuffer::same_size(const ConsoleBuffer& other) const -> bool {
+    return cols_ == other.cols_ && rows_ == other.rows_;
+}
+
+auto ConsoleBuffer::plane_offset(const ConsolePlane plane) const -> size_t {
+    return plane_index(plane) * cell_count();
+}
+
+auto ConsoleBuffer::plane(const ConsolePlane plane) -> std::span<uint8_t> {
+    return std::span(planes_).subspan(plane_offset(plane), cell_count());
+}
+
+auto ConsoleBuffer::plane(const ConsolePlane plane) const
+        -> std::span<const uint8_t> {
+    return std::span(planes_).subspan(plane_offset(plane), cell_count());
+}
+
+auto ConsoleBuffer::cell(const size_t index) const -> ConsoleCell {
+    assert(index < cell_count());
+    const size_t stride = cell_count();
+    const auto*  base   = planes_.data() + index;
+    return {.glyph = base[0],
+            .flags = base[stride],
+            .fg    = {base[2 * stride], base[3 * stride], base[4 * stride]},
+            .bg    = {base[5 * stride], base[6 * stride], base[7 * stride]}};
+}
+
+void ConsoleBuffer::set_cell(const size_t index, const ConsoleCell& cell) {
+    assert(index < cell_count());
+    const size_t stride = cell_count();
+    auto*        base   = planes_.data() + index;
+    base[0]             = cell.glyph;
+    base[stride]        = cell.flags;
+    base[2 * stride]    = cell.fg.r;
+    base[3 * stride]    = cell.fg.g;
+    base[4 * stride]    = cell.fg.b;
+    base[5 * stride]    = cell.bg.r;
+    base[6 * stride]    = cell.bg.g;
+    base[7 * stride]    = cell.bg.b;
+}
+
+auto ConsoleBuffer::cell_at(const uint32_t col, const uint32_t row) const
+        -> ConsoleCell {
+    return cell((static_cast<size_t>(row) * cols_) + col);
+}
+
+void ConsoleBuffer::set_cell_at(
+        const uint32_t col, const uint32_t row, const ConsoleCell& cell) {
+    set_cell((static_cast<size_t>(row) * cols_) + col, cell);
+}
+
+void ConsoleBuffer::fill(const ConsoleCell& cell) {
+    std::array<uint8_t, CONSOLE_PLANE_COUNT> values{};
+    values[plane_index(ConsolePlane::Glyph)] = cell.glyph;
+    values[plane_index(ConsolePlane::Flags)] = cell.flags;
+    values[plane_index(ConsolePlane::FgR)]   = cell.fg.r;
+    values[plane_index(ConsolePlane::FgG)]   = cell.fg.g;
+    values[plane_index(ConsolePlane::FgB)]   = cell.fg.b;
+    values[plane_index(ConsolePlane::BgR)]   = cell.bg.r;
+    values[plane_index(ConsolePlane::BgG)]   = cell.bg.g;
+    values[plane_index(ConsolePlane::BgB)]   = cell.bg.b;
+    for (size_t plane_idx = 0; plane_idx < CONSOLE_PLANE_COUNT; ++plane_idx) {
+        std::ranges::fill(plane(static_cast<ConsolePlane>(plane_idx)),
+                values[plane_idx]);
+    }
+}
+
+void ConsoleBuffer::clear() {
+    std::ranges::fill(planes_, 0);
+}
+
+void ConsoleBuffer::copy_cells(
+        const ConsoleBuffer& source, const size_t first, const size_t count) {
+    assert(same_size(source) && first + count <= cell_count());
+    for (size_t plane_idx = 0; plane_idx < CONSOLE_PLANE_COUNT; ++plane_idx) {
+        const auto plane_id = static_cast<ConsolePlane>(plane_idx);
+        std::memcpy(plane(plane_id).data() + first,
+                source.plane(plane_id).data() + first,
+                count);
+    }
+}
+
+void ConsoleBuffer::translate_cells(const std::span<const uint8_t> keys,
+        const CellLut& lut, const size_t first) {
+    assert(first + keys.size() <= cell_count());
+    for (size_t plane_idx = 0; plane_idx < CONSOLE_PLANE_COUNT; ++plane_idx) {
+        lookup_bytes(plane(static_cast<ConsolePlane>(plane_idx)).data() + first,
+                keys.data(),
+                lut[plane_idx],
+                keys.size());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Composition
+//-----------------------------------------------------------------------------
+void ConsoleBuffer::compose_rows(const ConsoleBuffer& layer,
+        const uint32_t first_row, const uint32_t row_count) {
+    assert(same_size(layer) && first_row + row_count <= rows_);
+    const size_t first = static_cast<size_t>(first_row) * cols_;
+    const size_t count = static_cast<size_t>(row_count) * cols_;
+
+    // Masks are built once per band, then every plane is one select pass.
+    // Thread-local so concurrent row bands never share scratch.
+    thread_local std::vector<uint8_t> glyph_mask;
+    thread_local std::vector<uint8_t> bg_mask;
+    glyph_mask.resize(count);
+    bg_mask.resize(count);
+    build_masks(layer.plane(ConsolePlane::Glyph).data() + first,
+            layer.plane(ConsolePlane::Flags).data() + first,
+            glyph_mask.data(),
+            bg_mask.data(),
+            count);
+
+    for (size_t plane_idx = 0; plane_idx < CONSOLE_PLANE_COUNT; ++plane_idx) {
+        const auto plane_id = static_cast<ConsolePlane>(plane_idx);
+        const bool is_bg    = plane_id >= ConsolePlane::BgR;
+        select_bytes(plane(plane_id).data() + first,
+                layer.plane(plane_id).data() + first,
+                is_bg ? bg_mask.data() : glyph_mask.data(),
+                count);
+    }
+}
+
+void ConsoleBuffer::compose(const ConsoleBuffer& layer) {
+    compose_rows(layer, 0, rows_);
+}
+
+void ConsoleBuffer::light_rows(const std::span<const uint8_t> light,
+        const uint32_t first_row, const uint32_t row_count) {
+    assert(light.size() == cell_count() && first_row + row_count <= rows_);
+    const size_t first = static_cast<size_t>(first_row) * cols_;
+    const size_t count = static_cast<size_t>(row_count) * cols_;
+
+    for (const auto plane_id : {ConsolePlane::FgR,
+                 ConsolePlane::FgG,
+                 ConsolePlane::FgB,
+                 ConsolePlane::BgR,
+                 ConsolePlane::BgG,
+                 ConsolePlane::BgB}) {
+        scale_bytes(plane(plane_id).data() + first, light.data() + first, count);
+    }
+}
+
+void ConsoleBuffer::light(const std::span<const uint8_t> light) {
+    light_rows(light, 0, rows_);
+}
@@ -0,0 +1,163 @@
+//-----------------------------------------------------------------------------
+// src/engine/rendering/console/console_buffer.ixx
+// Per-cell console contents (glyph, colors, flags) stored as SoA byte planes
+//-----------------------------------------------------------------------------
+module;
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module Engine.Rendering.Console;
+
+import Engine.Core;
+
+//-----------------------------------------------------------------------------
+// Cell flags
+//-----------------------------------------------------------------------------
+// The cell also paints its background when composed over a lower layer;
+// without it only glyph, foreground and flags are replaced.
+export constexpr uint8_t CELL_PAINTS_BACKGROUND = 1U << 0U;
+
+// One console cell as seen by callers. Glyph 0 means "empty" in overlay
+// layers: composing it leaves the cell below untouched.
+export struct ConsoleCell {
+    uint8_t glyph{0};
+    uint8_t flags{0};
+    Rgb8    fg{};
+    Rgb8    bg{};
+
+    friend constexpr auto operator==(const ConsoleCell&, const ConsoleCell&)
+            -> bool = default;
+};
+
+static_assert(sizeof(ConsoleCell) == 8);
+
+// Byte planes, in storage order; every cell has one byte in each plane
+export enum class ConsolePlane : uint8_t {
+    Glyph = 0,
+    Flags,
+    FgR,
+    FgG,
+    FgB,
+    BgR,
+    BgG,
+    BgB,
+};
+
+export constexpr size_t CONSOLE_PLANE_COUNT = 8;
+
+// Position of a plane in per-plane arrays (CellLut, fill values, storage)
+export constexpr auto plane_index(const ConsolePlane plane) -> size_t {
+    return static_cast<size_t>(plane);
+}
+
+static_assert(plane_index(ConsolePlane::Glyph) == 0 &&
+                      plane_index(ConsolePlane::BgB) + 1 == CONSOLE_PLANE_COUNT,
+        "ConsolePlane must enumerate exactly the planes, from 0");
+
+// Per-cell work (composition, vertex building) is split into row bands of
+// about this many cells, enough to outweigh the cost of scheduling a job.
+// The game's 80x25 console (2000 cells) is a single band and runs inline on
+// the calling thread; only consoles past 4096 cells (e.g. 160x50) are split.
+// Smaller bands would cost more in hand-off than the sub-millisecond work.
+export constexpr size_t CONSOLE_CELLS_PER_JOB = 4096;
+
+export constexpr auto console_rows_per_job(const uint32_t cols) -> size_t {
+    return cols == 0 || cols >= CONSOLE_CELLS_PER_JOB
+                   ? 1
+                   : CONSOLE_CELLS_PER_JOB / cols;
+}
+
+//-----------------------------------------------------------------------------
+// Byte-key lookup tables
+//-----------------------------------------------------------------------------
+// Maps a one-byte key (tile type, terrain id, ...) to a cell, stored per
+// plane so translation is one table lookup per plane byte.
+export using CellLut =
+        std::array<std::array<uint8_t, 256>, CONSOLE_PLANE_COUNT>;
+
+// Build a CellLut at compile time from any constexpr key -> ConsoleCell
+// mapping, e.g. `constexpr auto LUT = make_cell_lut(cell_for_key);`
+export template <typename CellForKey>
+constexpr auto make_cell_lut(CellForKey cell_for_key) -> CellLut {
+    CellLut lut{};
+    for (size_t key = 0; key < 256; ++key) {
+        const ConsoleCell cell = cell_for_key(static_cast<uint8_t>(key));
+        lut[plane_index(ConsolePlane::Glyph)][key] = cell.glyph;
+        lut[plane_index(ConsolePlane::Flags)][key] = cell.flags;
+        lut[plane_index(ConsolePlane::FgR)][key]   = cell.fg.r;
+        lut[plane_index(ConsolePlane::FgG)][key]   = cell.fg.g;
+        lut[plane_index(ConsolePlane::FgB)][key]   = cell.fg.b;
+        lut[plane_index(ConsolePlane::BgR)][key]   = cell.bg.r;
+        lut[plane_index(ConsolePlane::BgG)][key]   = cell.bg.g;
+        lut[plane_index(ConsolePlane::BgB)][key]   = cell.bg.b;
+    }
+    return lut;
+}
+
+//-----------------------------------------------------------------------------
+// ConsoleBuffer
+//-----------------------------------------------------------------------------
+// cols x rows cells, row-major, one contiguous plane per ConsoleCell field.
+// The SoA layout lets composition run as straight SIMD byte kernels over
+// rows, and lets replication/rendering stream single planes.
+export class ConsoleBuffer {
+public:
+    ConsoleBuffer() = default;
+    ConsoleBuffer(uint32_t cols, uint32_t rows);
+
+    // Resize and zero every cell (an all-empty layer)
+    void resize(uint32_t cols, uint32_t rows);
+
+    [[nodiscard]] auto cols() const -> uint32_t;
+    [[nodiscard]] auto rows() const -> uint32_t;
+    [[nodiscard]] auto cell_count() const -> size_t;
+    [[nodiscard]] auto same_size(const ConsoleBuffer& other) const -> bool;
+
+    // Gather / scatter one cell across the planes
+    [[nodiscard]] auto cell(size_t index) const -> ConsoleCell;
+    void               set_cell(size_t index, const ConsoleCell& cell);
+    [[nodiscard]] auto cell_at(uint32_t col, uint32_t row) const -> ConsoleCell;
+    void set_cell_at(uint32_t col, uint32_t row, const ConsoleCell& cell);
+
+    void fill(const ConsoleCell& cell);
+    void clear(); // all planes to zero
+
+    // Copy cells [first, first + count) of each plane from a same-sized buffer
+    void copy_cells(const ConsoleBuffer& source, size_t first, size_t count);
+
+    // Overwrite cells [first, first + keys.size()) with lut[key] for each key.
+    // Uses SSSE3 shuffles only when the build targets SSSE3 (not the default).
+    void translate_cells(
+            std::span<const uint8_t> keys, const CellLut& lut, size_t first);
+
+    [[nodiscard]] auto plane(ConsolePlane plane) -> std::span<uint8_t>;
+    [[nodiscard]] auto plane(ConsolePlane plane) const
+            -> std::span<const uint8_t>;
+
+    // ======= Composition (SSE2 with a scalar fallback) =======
+    // Both operate on whole rows [first_row, first_row + row_count) so
+    // callers can split a frame into independent row bands.
+
+    // Overlay `layer` (same size) onto this buffer: every cell with a
+    // non-zero glyph replaces glyph, flags and fg; its bg too if it has
+    // CELL_PAINTS_BACKGROUND.
+    void compose_rows(const ConsoleBuffer& layer, uint32_t first_row,
+                      uint32_t row_count);
+    void compose(const ConsoleBuffer& layer);
+
+    // Scale fg and bg by a per-cell light level (255 = unchanged, 0 = black),
+    // e.g. FOV or lighting. `light` holds one byte per cell.
+    void light_rows(std::span<const uint8_t> light, uint32_t first_row,
+                    uint32_t row_count);
+    void light(std::span<const uint8_t> light);
+
+private:
+    [[nodiscard]] auto plane_offset(ConsolePlane plane) const -> size_t;
+
+    uint32_t             cols_{0};
+    uint32_t             rows_{0};
+    std::vector<uint8_t> planes_; // CONSOLE_PLANE_COUNT * cols_ * rows_
+};
@@ -81,7 +81,7 @@ public:
                      0,
                      image.format,
                      GL_UNSIGNED_BYTE,
-                     image.pixels.data());
+                     image.pixels().data());
     }
 
     void execute(const std::vector<RenderCommand>& commands) override {
@@ -5,11 +5,15 @@ module;
 #include "glm/ext/matrix_clip_space.hpp"
 #include "glm/gtc/type_ptr.inl"
 
-#include <SDL3_image/SDL_image.h>
 #include <array>
+#include <cstddef>
 #include <glad/gl.h>
+#include <algorithm>
+#include <cstring>
 #include <optional>
-#include <print>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 module Engine.Rendering.GlyphRenderer;
@@ -24,11 +28,54 @@ static constexpr float    GLYPH_HEIGHT      = static_cast<float>(TILE_HEIGHT);
 static constexpr uint32_t ATLAS_COLS        = 32;
 static constexpr uint32_t ATLAS_ROWS        = 8;
 static constexpr size_t   VERTICES_PER_QUAD = 6;
-static constexpr size_t   FLOATS_PER_VERTEX = 4;
+
+// Text is drawn over a transparent background
+static constexpr std::array<uint8_t, 4> TEXT_BG = {0, 0, 0, 0};
+
+// Retained text buffer: starting size, and how many frames a string survives
+// unqueued before compaction may evict it
+static constexpr size_t   TEXT_INITIAL_VERTICES = 4096 * VERTICES_PER_QUAD;
+static constexpr uint64_t TEXT_RETAIN_FRAMES    = 120;
 
 //-----------------------------------------------------------------------------
 // Internal Helpers
 //-----------------------------------------------------------------------------
+struct GlyphQuad {
+    float                  pos_x;
+    float                  pos_y;
+    float                  width;
+    float                  height;
+    float                  min_u;
+    float                  min_v;
+    float                  max_u;
+    float                  max_v;
+    std::array<uint8_t, 4> fg;
+    std::array<uint8_t, 4> bg;
+};
+
+// Two triangles: top-left, bottom-left, bottom-right / top-left,
+// bottom-right, top-right (screen space, y down)
+static auto quad_vertices(const GlyphQuad& quad)
+        -> std::array<GlyphVertex, VERTICES_PER_QUAD> {
+    const float right  = quad.pos_x + quad.width;
+    const float bottom = quad.pos_y + quad.height;
+    // clang-format off
+    return {{
+        {quad.pos_x, bottom,     quad.min_u, quad.max_v, quad.fg, quad.bg},
+        {quad.pos_x, quad.pos_y, quad.min_u, quad.min_v, quad.fg, quad.bg},
+        {right,      quad.pos_y, quad.max_u, quad.min_v, quad.fg, quad.bg},
+        {quad.pos_x, bottom,     quad.min_u, quad.max_v, quad.fg, quad.bg},
+        {right,      quad.pos_y, quad.max_u, quad.min_v, quad.fg, quad.bg},
+        {right,      bottom,     quad.max_u, quad.max_v, quad.fg, quad.bg},
+    }};
+    // clang-format on
+}
+
+static void append_quad(std::vector<GlyphVertex>& out, const GlyphQuad& quad) {
+    const auto verts = quad_vertices(quad);
+    out.insert(out.end(), verts.begin(), verts.end());
+}
+
 static auto compile_shader(const uint32_t type, const char* src) -> uint32_t {
     const uint32_t shader_id = glCreateShader(type);
     glShaderSource(shader_id, 1, &src, nullptr);
@@ -36,40 +83,79 @@ static auto compile_shader(const uint32_t type, const char* src) -> uint32_t {
     return shader_id;
 }
 
+// Vertex layout for whichever VAO/VBO pair is bound
+static void set_vertex_layout() {
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0,
+            4,
+            GL_FLOAT,
+            GL_FALSE,
+            sizeof(GlyphVertex),
+            reinterpret_cast<const void*>(offsetof(GlyphVertex, pos_x)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1,
+            4,
+            GL_UNSIGNED_BYTE,
+            GL_TRUE,
+            sizeof(GlyphVertex),
+            reinterpret_cast<const void*>(offsetof(GlyphVertex, fg)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2,
+            4,
+            GL_UNSIGNED_BYTE,
+            GL_TRUE,
+            sizeof(GlyphVertex),
+            reinterpret_cast<const void*>(offsetof(GlyphVertex, bg)));
+}
+
 //-----------------------------------------------------------------------------
 // Factory and Special Members
 //-----------------------------------------------------------------------------
-auto GlyphRenderer::create(const char* atlas_path, const uint32_t screen_width,
-        const uint32_t screen_height) -> std::optional<GlyphRenderer> {
+auto GlyphRenderer::create(TextureHandle atlas, const uint32_t screen_width,
+        const uint32_t screen_height, ThreadPool& jobs)
+        -> std::optional<GlyphRenderer> {
     GlyphRenderer instance;
-    if (!instance.init(atlas_path, screen_width, screen_height)) {
+    if (!instance.init(std::move(atlas), screen_width, screen_height, jobs)) {
         return std::nullopt;
     }
     return std::make_optional<GlyphRenderer>(std::move(instance));
 }
 
 GlyphRenderer::GlyphRenderer(GlyphRenderer&& other) noexcept
-    : font_texture_(other.font_texture_), vao_(other.vao_), vbo_(other.vbo_),
+    : jobs_(other.jobs_), atlas_(std::move(other.atlas_)), vao_(other.vao_),
+      vbo_(other.vbo_),
       shader_program_(other.shader_program_),
       u_projection_loc_(other.u_projection_loc_),
       projection_matrix_(other.projection_matrix_),
       glyph_width_(other.glyph_width_), glyph_height_(other.glyph_height_),
       atlas_cols_(other.atlas_cols_), atlas_rows_(other.atlas_rows_),
-      screen_width_(other.screen_width_), screen_height_(other.screen_height_) {
-    other.font_texture_     = 0;
+      screen_width_(other.screen_width_), screen_height_(other.screen_height_),
+      console_vertices_(std::move(other.console_vertices_)),
+      text_vao_(other.text_vao_), text_vbo_(other.text_vbo_),
+      text_capacity_(other.text_capacity_),
+      text_vertices_(std::move(other.text_vertices_)),
+      text_cache_(std::move(other.text_cache_)),
+      text_key_(std::move(other.text_key_)), text_frame_(other.text_frame_),
+      text_queue_(std::move(other.text_queue_)),
+      text_firsts_(std::move(other.text_firsts_)),
+      text_counts_(std::move(other.text_counts_)) {
     other.vao_              = 0;
     other.vbo_              = 0;
     other.shader_program_   = 0;
     other.u_projection_loc_ = -1;
     other.screen_width_     = 0;
     other.screen_height_    = 0;
+    other.text_vao_         = 0;
+    other.text_vbo_         = 0;
+    other.text_capacity_    = 0;
 }
 
 auto GlyphRenderer::operator=(GlyphRenderer&& other) noexcept
         -> GlyphRenderer& {
     if (this != &other) {
         cleanup();
-        font_texture_      = other.font_texture_;
+        jobs_              = other.jobs_;
+        atlas_             = std::move(other.atlas_);
         vao_               = other.vao_;
         vbo_               = other.vbo_;
         shader_program_    = other.shader_program_;
@@ -81,14 +167,27 @@ auto GlyphRenderer::operator=(GlyphRenderer&& other) noexcept
         atlas_rows_        = other.atlas_rows_;
         screen_width_      = other.screen_width_;
         screen_height_     = other.screen_height_;
+        console_vertices_  = std::move(other.console_vertices_);
+        text_vao_          = other.text_vao_;
+        text_vbo_          = other.text_vbo_;
+        text_capacity_     = other.text_capacity_;
+        text_vertices_     = std::move(other.text_vertices_);
+        text_cache_        = std::move(other.text_cache_);
+        text_key_          = std::move(other.text_key_);
+        text_frame_        = other.text_frame_;
+        text_queue_        = std::move(other.text_queue_);
+        text_firsts_       = std::move(other.text_firsts_);
+        text_counts_       = std::move(other.text_counts_);
 
-        other.font_texture_     = 0;
         other.vao_              = 0;
         other.vbo_              = 0;
         other.shader_program_   = 0;
         other.u_projection_loc_ = -1;
         other.screen_width_     = 0;
         other.screen_height_    = 0;
+        other.text_vao_         = 0;
+        other.text_vbo_         = 0;
+        other.text_capacity_    = 0;
     }
     return *this;
 }
@@ -100,8 +199,13 @@ GlyphRenderer::~GlyphRenderer() {
 //-----------------------------------------------------------------------------
 // Initialization & Cleanup
 //-----------------------------------------------------------------------------
-auto GlyphRenderer::init(const char* atlas_path, const uint32_t screen_width,
-        const uint32_t screen_height) -> bool {
+auto GlyphRenderer::init(TextureHandle atlas, const uint32_t screen_width,
+        const uint32_t screen_height, ThreadPool& jobs) -> bool {
+    if (!atlas.valid() || atlas.state() == AssetState::Failed) {
+        return false;
+    }
+    jobs_          = &jobs;
+    atlas_         = std::move(atlas);
     screen_width_  = screen_width;
     screen_height_ = screen_height;
     glyph_width_   = GLYPH_WIDTH;
@@ -109,48 +213,39 @@ auto GlyphRenderer::init(const char* atlas_path, const uint32_t screen_width,
     atlas_cols_    = ATLAS_COLS;
     atlas_rows_    = ATLAS_ROWS;
 
-    SDL_Surface* surface = IMG_Load(atlas_path);
-    if (surface == nullptr) {
-        std::println(
-                stderr, "Failed to load '{}': {}", atlas_path, SDL_GetError());
-        return false;
-    }
-
-    glGenTextures(1, &font_texture_);
-    glBindTexture(GL_TEXTURE_2D, font_texture_);
-    const int32_t format =
-            (SDL_BYTESPERPIXEL(surface->format) == 4 ? GL_RGBA : GL_RGB);
-    glTexImage2D(GL_TEXTURE_2D,
-            0,
-            format,
-            surface->w,
-            surface->h,
-            0,
-            format,
-            GL_UNSIGNED_BYTE,
-            surface->pixels);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    SDL_DestroySurface(surface);
-
     constexpr auto VS_SOURCE = R"GLSL(
     #version 330 core
     layout(location=0) in vec4 a_pos_uv;
+    layout(location=1) in vec4 a_fg;
+    layout(location=2) in vec4 a_bg;
     out vec2 v_uv;
+    out vec4 v_fg;
+    out vec4 v_bg;
     uniform mat4 u_proj;
     void main() {
         gl_Position = u_proj * vec4(a_pos_uv.xy, 0, 1);
         v_uv = a_pos_uv.zw;
+        v_fg = a_fg;
+        v_bg = a_bg;
     }
     )GLSL";
 
+    // Background fill and glyph in one pass: the atlas only supplies
+    // coverage, and the output is premultiplied so a transparent background
+    // (text) blends the same way as an opaque one (console cells).
     constexpr auto FS_SOURCE = R"GLSL(
     #version 330 core
     in vec2 v_uv;
+    in vec4 v_fg;
+    in vec4 v_bg;
     uniform sampler2D u_tex;
     out vec4 frag;
     void main() {
-        frag = texture(u_tex, v_uv);
+        vec4  texel    = texture(u_tex, v_uv);
+        float coverage = texel.a * max(texel.r, max(texel.g, texel.b)) * v_fg.a;
+        float bg_alpha = v_bg.a * (1.0 - coverage);
+        frag = vec4(v_fg.rgb * coverage + v_bg.rgb * bg_alpha,
+                    coverage + bg_alpha);
     }
     )GLSL";
 
@@ -168,12 +263,20 @@ auto GlyphRenderer::init(const char* atlas_path, const uint32_t screen_width,
     glGenBuffers(1, &vbo_);
     glBindVertexArray(vao_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    set_vertex_layout();
+
+    // Retained text lives in its own buffer, so console uploads never
+    // disturb it
+    glGenVertexArrays(1, &text_vao_);
+    glGenBuffers(1, &text_vbo_);
+    glBindVertexArray(text_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, text_vbo_);
+    set_vertex_layout();
+    text_capacity_ = TEXT_INITIAL_VERTICES;
     glBufferData(GL_ARRAY_BUFFER,
-            VERTICES_PER_QUAD * FLOATS_PER_VERTEX * sizeof(float),
+            static_cast<GLsizeiptr>(text_capacity_ * sizeof(GlyphVertex)),
             nullptr,
             GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
 
     const auto width  = static_cast<float>(screen_width_);
     const auto height = static_cast<float>(screen_height_);
@@ -196,17 +299,31 @@ void GlyphRenderer::cleanup() {
         glDeleteVertexArrays(1, &vao_);
         vao_ = 0;
     }
-    if (font_texture_ != 0U) {
-        glDeleteTextures(1, &font_texture_);
-        font_texture_ = 0;
+    if (text_vbo_ != 0U) {
+        glDeleteBuffers(1, &text_vbo_);
+        text_vbo_ = 0;
+    }
+    if (text_vao_ != 0U) {
+        glDeleteVertexArrays(1, &text_vao_);
+        text_vao_ = 0;
     }
+    console_vertices_.clear();
+    text_capacity_ = 0;
+    text_vertices_.clear();
+    text_cache_.clear();
+    text_queue_.clear();
+    atlas_ = {};
 }
 
 //-----------------------------------------------------------------------------
-// Rendering: Single-string and Batch
+// Rendering: Retained Text and Console Batch
 //-----------------------------------------------------------------------------
-auto GlyphRenderer::render_text(const char* text, const int32_t start_col,
-        const int32_t start_row) const -> void {
+auto GlyphRenderer::bind_pipeline() const -> bool {
+    const TextureInfo* atlas = atlas_.texture();
+    if (atlas == nullptr) {
+        return false; // still streaming in (or failed to load)
+    }
+
     glUseProgram(shader_program_);
 
     // Bind the VAO/VBO for drawing quads
@@ -215,15 +332,89 @@ auto GlyphRenderer::render_text(const char* text, const int32_t start_col,
 
     // Activate texture unit 0 and bind the font atlas
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, font_texture_);
+    glBindTexture(GL_TEXTURE_2D, atlas->id);
 
-    // Enable blending for alpha transparency (font antialiasing)
+    // Enable blending; the fragment shader outputs premultiplied alpha
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 
     // Upload the orthographic projection matrix to the shader
     glUniformMatrix4fv(
             u_projection_loc_, 1, GL_FALSE, glm::value_ptr(projection_matrix_));
+    return true;
+}
+
+auto GlyphRenderer::render_text(const char* text, const int32_t start_col,
+        const int32_t start_row, const Rgb8 color) -> void {
+    TextEntry& entry = find_or_add_text(text, start_col, start_row, color);
+
+    // Queue each string at most once per frame
+    if (entry.last_used_frame != text_frame_) {
+        entry.last_used_frame = text_frame_;
+        text_queue_.push_back(&entry);
+    }
+}
+
+void GlyphRenderer::flush_text() {
+    if (!text_queue_.empty() && bind_pipeline()) {
+        // Strings cached back to back in the buffer merge into one range
+        text_firsts_.clear();
+        text_counts_.clear();
+        for (const TextEntry* entry : text_queue_) {
+            const auto first = static_cast<int32_t>(entry->first_vertex);
+            const auto count = static_cast<int32_t>(entry->vertex_count);
+            if (count == 0) {
+                continue;
+            }
+            if (!text_firsts_.empty() &&
+                    text_firsts_.back() + text_counts_.back() == first) {
+                text_counts_.back() += count;
+            } else {
+                text_firsts_.push_back(first);
+                text_counts_.push_back(count);
+            }
+        }
+
+        // All queued text in one call, straight from the retained buffer
+        if (!text_firsts_.empty()) {
+            glBindVertexArray(text_vao_);
+            glMultiDrawArrays(GL_TRIANGLES,
+                    text_firsts_.data(),
+                    text_counts_.data(),
+                    static_cast<GLsizei>(text_firsts_.size()));
+        }
+    }
+    text_queue_.clear();
+    ++text_frame_;
+}
+
+auto GlyphRenderer::find_or_add_text(const char* text, const int32_t start_col,
+        const int32_t start_row, const Rgb8 color) -> TextEntry& {
+    // Key: position and color bytes followed by the string; text_key_ keeps
+    // its capacity, so a cache hit allocates nothing
+    constexpr size_t KEY_PREFIX =
+            sizeof(start_col) + sizeof(start_row) + sizeof(color);
+    const size_t length = std::strlen(text);
+    text_key_.resize(KEY_PREFIX);
+    std::memcpy(text_key_.data(), &start_col, sizeof(start_col));
+    std::memcpy(text_key_.data() + sizeof(start_col),
+            &start_row,
+            sizeof(start_row));
+    std::memcpy(text_key_.data() + sizeof(start_col) + sizeof(start_row),
+            &color,
+            sizeof(color));
+    text_key_.append(text, length);
+
+    if (const auto found = text_cache_.find(text_key_);
+            found != text_cache_.end()) {
+        return found->second;
+    }
+
+    const size_t vertex_count = length * VERTICES_PER_QUAD;
+    if (text_vertices_.size() + vertex_count > text_capacity_) {
+        compact_text(vertex_count);
+    }
+    const size_t first_vertex = text_vertices_.size();
 
     // ------------------------------------------------------------------------
     // Compute how much UV space each glyph occupies
@@ -239,8 +430,8 @@ auto GlyphRenderer::render_text(const char* text, const int32_t start_col,
     const float    uv_scale_y = 1.F / static_cast<float>(atlas_rows_);
     uint32_t       col_idx    = start_col; // Current column on screen
     const uint32_t row_idx    = start_row; // Fixed starting row
+    const std::array<uint8_t, 4> text_fg = {color.r, color.g, color.b, 255};
 
-    // Iterate over each character in the null-terminated string
     for (const char* ptr = text; *ptr != 0; ++ptr, ++col_idx) {
         // Get the character code (0-255)
         const auto glyph_code = static_cast<uint8_t>(*ptr);
@@ -252,56 +443,77 @@ auto GlyphRenderer::render_text(const char* text, const int32_t start_col,
         // Calculate UV coordinates in normalized [0,1] space
         const float min_u = static_cast<float>(tile_x_idx) * uv_scale_x;
         const float min_v = static_cast<float>(tile_y_idx) * uv_scale_y;
-        const float max_u = min_u + uv_scale_x;
-        const float max_v = min_v + uv_scale_y;
-
-        // Calculate the screen position of the glyph in pixels
-        const float pos_x = static_cast<float>(col_idx) * glyph_width_;
-        const float pos_y = static_cast<float>(row_idx) * glyph_height_;
-
-        // Build the 6 vertices (2 triangles) for the quad:
-        // Each vertex has 4 floats: x, y, u, v
-        // Triangle 1: top-left, bottom-left, bottom-right
-        // Triangle 2: top-left, bottom-right, top-right
-        // clang-format off
-        std::array<std::array<float, FLOATS_PER_VERTEX>, VERTICES_PER_QUAD> verts = {{
-            {{ pos_x,                 pos_y + glyph_height_, min_u, max_v }},
-            {{ pos_x,                 pos_y,                 min_u, min_v }},
-            {{ pos_x + glyph_width_,  pos_y,                 max_u, min_v }},
-            {{ pos_x,                 pos_y + glyph_height_, min_u, max_v }},
-            {{ pos_x + glyph_width_,  pos_y,                 max_u, min_v }},
-            {{ pos_x + glyph_width_,  pos_y + glyph_height_, max_u, max_v }}
-        }};
-        // clang-format on
-
-        // Update the VBO with our quad's vertex data
-        glBufferSubData(GL_ARRAY_BUFFER,
-                0,
-                VERTICES_PER_QUAD * FLOATS_PER_VERTEX * sizeof(float),
-                verts.data());
-        glDrawArrays(GL_TRIANGLES, 0, VERTICES_PER_QUAD);
+
+        append_quad(text_vertices_,
+                {.pos_x  = static_cast<float>(col_idx) * glyph_width_,
+                        .pos_y  = static_cast<float>(row_idx) * glyph_height_,
+                        .width  = glyph_width_,
+                        .height = glyph_height_,
+                        .min_u  = min_u,
+                        .min_v  = min_v,
+                        .max_u  = min_u + uv_scale_x,
+                        .max_v  = min_v + uv_scale_y,
+                        .fg     = text_fg,
+                        .bg     = TEXT_BG});
     }
-}
 
-void GlyphRenderer::render_console(
-        const char* glyphs, const uint32_t cols, const uint32_t rows) const {
-    glUseProgram(shader_program_);
+    // Upload only the new string; everything else in the buffer stays put
+    glBindBuffer(GL_ARRAY_BUFFER, text_vbo_);
+    glBufferSubData(GL_ARRAY_BUFFER,
+            static_cast<GLintptr>(first_vertex * sizeof(GlyphVertex)),
+            static_cast<GLsizeiptr>(vertex_count * sizeof(GlyphVertex)),
+            text_vertices_.data() + first_vertex);
 
-    // Bind the VAO/VBO for drawing batches of quads
-    glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    const TextEntry entry{.first_vertex = static_cast<uint32_t>(first_vertex),
+            .vertex_count = static_cast<uint32_t>(vertex_count)};
+    return text_cache_.emplace(text_key_, entry).first->second;
+}
 
-    // Activate and bind the font atlas texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, font_texture_);
+void GlyphRenderer::compact_text(const size_t extra_vertices) {
+    // Strings queued this frame are never stale, so text_queue_ stays valid
+    std::erase_if(text_cache_, [&](const auto& item) {
+        return item.second.last_used_frame + TEXT_RETAIN_FRAMES < text_frame_;
+    });
+
+    // Survivors keep their relative order, so strings that were drawn as one
+    // range still are
+    std::vector<TextEntry*> live;
+    live.reserve(text_cache_.size());
+    for (auto& [key, entry] : text_cache_) {
+        live.push_back(&entry);
+    }
+    std::ranges::sort(live, {}, &TextEntry::first_vertex);
+
+    std::vector<GlyphVertex> packed;
+    packed.reserve(text_vertices_.size() + extra_vertices);
+    for (TextEntry* entry : live) {
+        const auto source   = text_vertices_.begin() + entry->first_vertex;
+        entry->first_vertex = static_cast<uint32_t>(packed.size());
+        packed.insert(packed.end(), source, source + entry->vertex_count);
+    }
+    text_vertices_ = std::move(packed);
 
-    // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    const size_t required = text_vertices_.size() + extra_vertices;
+    if (required > text_capacity_) {
+        text_capacity_ = std::max(text_capacity_ * 2, required);
+    }
 
-    // Upload the orthographic projection matrix to the shader
-    glUniformMatrix4fv(
-            u_projection_loc_, 1, GL_FALSE, glm::value_ptr(projection_matrix_));
+    // Orphan the old storage and upload the survivors in one go
+    glBindBuffer(GL_ARRAY_BUFFER, text_vbo_);
+    glBufferData(GL_ARRAY_BUFFER,
+            static_cast<GLsizeiptr>(text_capacity_ * sizeof(GlyphVertex)),
+            nullptr,
+            GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER,
+            0,
+            static_cast<GLsizeiptr>(text_vertices_.size() * sizeof(GlyphVertex)),
+            text_vertices_.data());
+}
+
+void GlyphRenderer::render_console(const ConsoleBuffer& console) {
+    if (!bind_pipeline()) {
+        return;
+    }
 
     // Compute UV step per glyph in atlas
     const float uv_step_x = 1.F / static_cast<float>(atlas_cols_);
@@ -311,51 +523,62 @@ void GlyphRenderer::render_console(
     const float tile_w = glyph_width_;
     const float tile_h = glyph_height_;
 
-    // Pre-allocate the vertex array for the whole console
-    std::vector<float> verts;
-    verts.reserve(static_cast<size_t>(cols) * rows * VERTICES_PER_QUAD *
-                  FLOATS_PER_VERTEX);
-
-    // Loop rows then columns to fill the screen in text grid order
-    for (uint32_t row_idx = 0; row_idx < rows; ++row_idx) {
-        for (uint32_t col_idx = 0; col_idx < cols; ++col_idx) {
-            // Get glyph code from the flat array
-            const auto glyph_code =
-                    static_cast<uint8_t>(glyphs[(row_idx * cols) + col_idx]);
-
-            // Compute tile indices in atlas
-            const uint32_t tile_x_idx = glyph_code % atlas_cols_;
-            const uint32_t tile_y_idx = glyph_code / atlas_cols_;
-
-            // Compute UV boundaries for this glyph
-            const float min_u = static_cast<float>(tile_x_idx) * uv_step_x;
-            const float min_v = static_cast<float>(tile_y_idx) * uv_step_y;
-            const float max_u = min_u + uv_step_x;
-            const float max_v = min_v + uv_step_y;
-
-            // Compute screen position of the glyph
-            const float pos_x = static_cast<float>(col_idx) * tile_w;
-            const float pos_y = static_cast<float>(row_idx) * tile_h;
-
-            // Build the 6 vertices (2 triangles) for the quad:
-            // clang-format off
-            verts.insert(verts.end(),
-                         // x,            y,              u,     v
-                         {pos_x,      pos_y + tile_h, min_u, max_v,
-                          pos_x,          pos_y,          min_u, min_v,
-                          pos_x + tile_w, pos_y,          max_u, min_v,
-                          pos_x,          pos_y + tile_h, min_u, max_v,
-                          pos_x + tile_w, pos_y,          max_u, min_v,
-                          pos_x + tile_w, pos_y + tile_h, max_u, max_v});
-            // clang-format on
+    const uint32_t cols   = console.cols();
+    const uint32_t rows   = console.rows();
+    const auto     glyphs = console.plane(ConsolePlane::Glyph);
+    const auto     fg_r   = console.plane(ConsolePlane::FgR);
+    const auto     fg_g   = console.plane(ConsolePlane::FgG);
+    const auto     fg_b   = console.plane(ConsolePlane::FgB);
+    const auto     bg_r   = console.plane(ConsolePlane::BgR);
+    const auto     bg_g   = console.plane(ConsolePlane::BgG);
+    const auto     bg_b   = console.plane(ConsolePlane::BgB);
+
+    // Every cell owns six vertices at a fixed offset, so row bands fill
+    // disjoint parts of the buffer and can be built in parallel
+    console_vertices_.resize(console.cell_count() * VERTICES_PER_QUAD);
+    GlyphVertex* const verts = console_vertices_.data();
+
+    const auto build_rows = [&](const size_t first_row, const size_t last_row) {
+        // Loop rows then columns to fill the screen in text grid order
+        for (size_t row_idx = first_row; row_idx < last_row; ++row_idx) {
+            for (uint32_t col_idx = 0; col_idx < cols; ++col_idx) {
+                const size_t cell = (row_idx * cols) + col_idx;
+
+                // Compute tile indices in atlas
+                const uint32_t tile_x_idx = glyphs[cell] % atlas_cols_;
+                const uint32_t tile_y_idx = glyphs[cell] / atlas_cols_;
+
+                // Compute UV boundaries for this glyph
+                const float min_u = static_cast<float>(tile_x_idx) * uv_step_x;
+                const float min_v = static_cast<float>(tile_y_idx) * uv_step_y;
+
+                // Every cell is a quad, so its background is filled in the
+                // same draw as the glyph (glyph 0 renders as background only)
+                const GlyphQuad quad{
+                        .pos_x  = static_cast<float>(col_idx) * tile_w,
+                        .pos_y  = static_cast<float>(row_idx) * tile_h,
+                        .width  = tile_w,
+                        .height = tile_h,
+                        .min_u  = min_u,
+                        .min_v  = min_v,
+                        .max_u  = min_u + uv_step_x,
+                        .max_v  = min_v + uv_step_y,
+                        .fg     = {fg_r[cell], fg_g[cell], fg_b[cell], 255},
+                        .bg     = {bg_r[cell], bg_g[cell], bg_b[cell], 255}};
+                std::ranges::copy(quad_vertices(quad),
+                        verts + (cell * VERTICES_PER_QUAD));
+            }
         }
-    }
+    };
+    jobs_->parallel_for(rows, console_rows_per_job(cols), build_rows);
 
     // Upload entire batch vertex data to GPU
-    const auto size = static_cast<GLsizeiptr>(verts.size() * sizeof(float));
-    glBufferData(GL_ARRAY_BUFFER, size, verts.data(), GL_DYNAMIC_DRAW);
+    const auto size = static_cast<GLsizeiptr>(
+            console_vertices_.size() * sizeof(GlyphVertex));
+    glBufferData(
+            GL_ARRAY_BUFFER, size, console_vertices_.data(), GL_DYNAMIC_DRAW);
 
     // Draw all quads in one call (count = total vertices)
-    const auto count = static_cast<GLsizei>(verts.size() / FLOATS_PER_VERTEX);
-    glDrawArrays(GL_TRIANGLES, 0, count);
+    glDrawArrays(
+            GL_TRIANGLES, 0, static_cast<GLsizei>(console_vertices_.size()));
 }
@@ -4,23 +4,54 @@
 module;
 #include "glm/mat4x4.hpp"
 
+#include <array>
 #include <cstdint>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 export module Engine.Rendering.GlyphRenderer;
 
+import Engine.Core;
+import Engine.Jobs.ThreadPool;
+import Engine.Assets.AssetManager;
+import Engine.Rendering.Console;
+
 //-----------------------------------------------------------------------------
 // Public API
 //-----------------------------------------------------------------------------
 constexpr uint32_t PROJECTION_MATRIX_SIZE = 16;
 
-// Loads a bitmap font atlas and renders strings or full-screen consoles.
+// Colors travel as normalized bytes, so a cell costs 6 x 24 bytes of vertices
+struct GlyphVertex {
+    float                  pos_x;
+    float                  pos_y;
+    float                  tex_u;
+    float                  tex_v;
+    std::array<uint8_t, 4> fg;
+    std::array<uint8_t, 4> bg; // alpha 0 leaves the background untouched
+};
+
+static_assert(sizeof(GlyphVertex) == 24);
+
+// A string whose quads live in the retained text buffer
+struct TextEntry {
+    uint32_t first_vertex{0};
+    uint32_t vertex_count{0};
+    uint64_t last_used_frame{0};
+};
+
+// Renders strings or full-screen consoles from a bitmap font atlas. The atlas
+// may still be streaming in; nothing is drawn until it is ready. Console
+// vertices are built on `jobs`; GL calls stay on the calling thread.
 export class GlyphRenderer {
 public:
     // Factory: constructs and initializes a renderer, or returns nullopt on
     // failure.
-    static auto create(const char* atlas_path, uint32_t screen_width,
-                       uint32_t screen_height) -> std::optional<GlyphRenderer>;
+    static auto create(TextureHandle atlas, uint32_t screen_width,
+                       uint32_t screen_height, ThreadPool& jobs)
+            -> std::optional<GlyphRenderer>;
 
     // non-copyable, movable
     GlyphRenderer(const GlyphRenderer&) = delete;
@@ -28,12 +59,20 @@ public:
     auto operator=(GlyphRenderer&&) noexcept -> GlyphRenderer&;
     ~GlyphRenderer();
 
-    // Render a null-terminated string at tile coordinates (col, row).
-    void render_text(const char* text, int32_t start_col,
-                     int32_t start_row) const;
+    // Queue a null-terminated string at tile coordinates (col, row). Its
+    // quads are built and uploaded the first time this exact string, position
+    // and color is seen, then reused every frame it is queued again.
+    void render_text(const char* text, int32_t start_col, int32_t start_row,
+                     Rgb8 color);
+
+    // Draw all text queued since the last flush in one call. Strings not
+    // queued for a while are evicted when the buffer next fills up.
+    void flush_text();
 
-    // Batch-render a full buffer of size cols × rows.
-    void render_console(const char* glyphs, uint32_t cols, uint32_t rows) const;
+    // Batch-render a full console: each cell's background is filled and its
+    // glyph tinted with its foreground color, all in a single draw. Row bands
+    // of vertices are built in parallel.
+    void render_console(const ConsoleBuffer& console);
 
     // Release GPU resources (safe to call multiple times).
     void cleanup();
@@ -41,11 +80,24 @@ public:
 private:
     // private constructor used by factory
     GlyphRenderer() = default;
-    auto init(const char* atlas_path, uint32_t screen_width,
-              uint32_t screen_height) -> bool;
+    auto init(TextureHandle atlas, uint32_t screen_width,
+              uint32_t screen_height, ThreadPool& jobs) -> bool;
+
+    // Binds program, VAO/VBO, atlas and projection; false if the atlas is
+    // not uploaded yet.
+    [[nodiscard]] auto bind_pipeline() const -> bool;
+
+    // Cache entry for text_key_, building and uploading its quads on a miss
+    auto find_or_add_text(const char* text, int32_t start_col,
+                          int32_t start_row, Rgb8 color) -> TextEntry&;
+
+    // Drop stale entries and repack the rest at the front of the text buffer,
+    // growing it if `extra_vertices` more would still not fit
+    void compact_text(size_t extra_vertices);
 
     // GPU resources and configuration
-    uint32_t  font_texture_{0};
+    ThreadPool*   jobs_{nullptr}; // not owned
+    TextureHandle atlas_;
     uint32_t  vao_{0};
     uint32_t  vbo_{0};
     uint32_t  shader_program_{0};
@@ -58,4 +110,23 @@ private:
     uint32_t atlas_rows_{};
     uint32_t screen_width_{};
     uint32_t screen_height_{};
+
+    // Console vertex scratch, reused across frames
+    std::vector<GlyphVertex> console_vertices_;
+
+    // Retained text: every cached string's quads, mirrored on the CPU so the
+    // buffer can be repacked without rebuilding them
+    uint32_t                                   text_vao_{0};
+    uint32_t                                   text_vbo_{0};
+    size_t                                     text_capacity_{0}; // vertices
+    std::vector<GlyphVertex>                   text_vertices_;
+    std::unordered_map<std::string, TextEntry> text_cache_;
+    std::string                                text_key_; // lookup scratch
+    uint64_t                                   text_frame_{1};
+
+    // Entries queued this frame (map nodes are stable) and the draw ranges
+    // they coalesce into
+    std::vector<const TextEntry*> text_queue_;
+    std::vector<int32_t>          text_firsts_;
+    std::vector<int32_t>          text_counts_;
 };
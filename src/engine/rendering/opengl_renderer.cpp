@@ -4,13 +4,14 @@ module;
 
 module Engine.Rendering.OpenGlRenderer;
 
-auto OpenGlRenderer::create(const char* atlas_path, std::uint32_t screen_width,
-        std::uint32_t screen_height) -> std::unique_ptr<IRenderer> {
+auto OpenGlRenderer::create(TextureHandle atlas, std::uint32_t screen_width,
+        std::uint32_t screen_height, ThreadPool& jobs)
+        -> std::unique_ptr<IRenderer> {
     // Use GlyphRenderer factory to initialize OpenGL glyph rendering
-    auto maybe_glyph =
-            GlyphRenderer::create(atlas_path, screen_width, screen_height);
+    auto maybe_glyph = GlyphRenderer::create(
+            std::move(atlas), screen_width, screen_height, jobs);
     if (!maybe_glyph) {
-        return nullptr; // initialization failed (e.g., texture not found)
+        return nullptr; // initialization failed (e.g., texture failed to load)
     }
     // Construct OpenGLRenderer with the initialized GlyphRenderer
     return std::unique_ptr<IRenderer>(
@@ -23,11 +24,14 @@ OpenGlRenderer::OpenGlRenderer(GlyphRenderer&& glyph_renderer)
 }
 
 void OpenGlRenderer::render_text(const char* text, std::int32_t start_col,
-        std::int32_t start_row) const {
-    glyph_renderer_.render_text(text, start_col, start_row);
+        std::int32_t start_row, Rgb8 color) {
+    glyph_renderer_.render_text(text, start_col, start_row, color);
 }
 
-void OpenGlRenderer::render_console(
-        const char* glyphs, std::uint32_t cols, std::uint32_t rows) const {
-    glyph_renderer_.render_console(glyphs, cols, rows);
+void OpenGlRenderer::render_console(const ConsoleBuffer& console) {
+    glyph_renderer_.render_console(console);
+}
+
+void OpenGlRenderer::flush_text() {
+    glyph_renderer_.flush_text();
 }
@@ -4,20 +4,28 @@ module;
 
 export module Engine.Rendering.OpenGlRenderer;
 
+import Engine.Core;
 import Engine.Rendering.RendererInterface;
 import Engine.Rendering.GlyphRenderer;
+import Engine.Assets.AssetManager;
+import Engine.Jobs.ThreadPool;
+import Engine.Rendering.Console;
 
 export class OpenGlRenderer final : public IRenderer {
 public:
-    // Create an OpenGL-based renderer (returns nullptr on failure).
-    static auto create(const char* atlas_path, std::uint32_t screen_width, std::uint32_t screen_height)
-           -> std::unique_ptr<IRenderer>;
+    // Create an OpenGL-based renderer (returns nullptr on failure). The atlas
+    // may still be loading; glyphs appear once it is uploaded. CPU-side
+    // vertex building runs on `jobs`.
+    static auto create(TextureHandle atlas, std::uint32_t screen_width, std::uint32_t screen_height,
+                       ThreadPool& jobs) -> std::unique_ptr<IRenderer>;
     OpenGlRenderer(const OpenGlRenderer&) = delete;
     auto operator=(const OpenGlRenderer&) -> OpenGlRenderer& = delete;
     ~OpenGlRenderer() override                               = default;
 
-    void render_text(const char* text, std::int32_t start_col, std::int32_t start_row) const override;
-    void render_console(const char* glyphs, std::uint32_t cols, std::uint32_t rows) const override;
+    void render_text(const char* text, std::int32_t start_col, std::int32_t start_row,
+                     Rgb8 color) override;
+    void render_console(const ConsoleBuffer& console) override;
+    void flush_text() override;
 private:
     // Private constructor used by the factory
     explicit OpenGlRenderer(GlyphRenderer&& glyph_renderer);
@@ -1,6 +1,7 @@
 module;
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 export module Engine.Rendering.Renderer;
@@ -27,13 +28,18 @@ struct RenderCommand {
 
 class RendererFrontend {
 public:
-    void submit(const RenderCommand& command) {
-        commands_.push_back(command);
+    // Takes the command by value: callers hand over their vertex data with
+    // std::move instead of having it copied
+    void submit(RenderCommand command) {
+        commands_.push_back(std::move(command));
     };
-    [[nodiscard]] auto get_commands() const {
+    [[nodiscard]] auto get_commands() const
+            -> const std::vector<RenderCommand>& {
         return commands_;
     };
-    void clear();
+    void clear() {
+        commands_.clear();
+    };
 
 private:
     std::vector<RenderCommand> commands_;
@@ -3,11 +3,18 @@ module;
 
 export module Engine.Rendering.RendererInterface;
 
+import Engine.Core;
+import Engine.Rendering.Console;
+
 export class IRenderer {
 public:
     virtual ~IRenderer() = default;
-    // Render a null-terminated string at the given tile coordinates (column, row).
-    virtual void render_text(const char* text, std::int32_t start_col, std::int32_t start_row) const = 0;
-    // Render an entire console of size cols × rows using a buffer of glyphs.
-    virtual void render_console(const char* glyphs, std::uint32_t cols, std::uint32_t rows) const = 0;
+    // Queue a null-terminated string at the given tile coordinates (column, row).
+    // Unchanged strings are cached, so re-queuing them every frame is cheap.
+    virtual void render_text(const char* text, std::int32_t start_col, std::int32_t start_row,
+                             Rgb8 color) = 0;
+    // Render an entire console (glyphs over filled backgrounds) in one pass.
+    virtual void render_console(const ConsoleBuffer& console) = 0;
+    // Draw all text queued this frame, on top of what was rendered so far.
+    virtual void flush_text() = 0;
 };
@@ -1,6 +1,10 @@
 module;
 #include <array>
-#include <print>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
 #include <utility>
 #include <vector>
 #include <memory>
@@ -15,10 +19,13 @@ import Engine.Config.TileConfig;
 import Engine.Ecs.Entity;
 
 constexpr Color DARK_GREY_COLOR{.r = 0.1F, .g = 0.1F, .b = 0.1F, .a = 1.0F};
+constexpr Rgb8  ERROR_TEXT_COLOR{.r = 255, .g = 255, .b = 255};
+constexpr Rgb8  OVERLAY_TEXT_COLOR{.r = 255, .g = 220, .b = 120};
 
-RenderSystem::RenderSystem(
-        SdlGlGraphicsContext& graphics_context, std::unique_ptr<IRenderer> renderer)
-    : graphics_context_(graphics_context), renderer_(std::move(renderer)) {
+RenderSystem::RenderSystem(SdlGlGraphicsContext& graphics_context,
+        std::unique_ptr<IRenderer> renderer, ThreadPool& jobs)
+    : graphics_context_(graphics_context), renderer_(std::move(renderer)),
+      jobs_(jobs) {
     // The renderer is initialized and owned by this RenderSystem
 }
 
@@ -26,78 +33,151 @@ void RenderSystem::set_world(Registry& world) {
     world_ = &world;
 }
 
-void RenderSystem::update(float /*delta_time*/) const {
+void RenderSystem::set_spatial_index(const SpatialIndex& index) {
+    spatial_index_ = &index;
+}
+
+void RenderSystem::set_overlay(const std::span<const std::string> lines) {
+    overlay_lines_.assign(lines.begin(), lines.end());
+}
+
+void RenderSystem::update(float /*delta_time*/) {
     // Clear screen to a dark gray background
     SdlGlGraphicsContext::begin_frame(DARK_GREY_COLOR);
 
+    // Overlay starts on the first row below the map, if there is one
+    std::int32_t overlay_row = 0;
+
     if (world_ != nullptr) {
         bool drew_map = false;
 
         // Batch renders any tile maps with overlays
         for (Entity entity : world_->entities_with<TileMap>()) {
-            auto&       tile_map = world_->get_component<TileMap>(entity);
-            const auto& glyphs   = tile_map.glyphs;
-            const auto  cols     = tile_map.cols;
-            const auto  rows     = tile_map.rows;
-
-            // Sanity check: ensure buffer size matches expected dimensions
-            const std::size_t expected_size =
-                    static_cast<std::size_t>(cols) * rows;
-            if (glyphs.size() != expected_size) {
-                std::println("WARNING: TileMap buffer size mismatch!");
-                continue;
-            }
+            const auto& cells =
+                    std::as_const(*world_).get_component<TileMap>(entity).cells;
 
-            // Prepare a combined glyph buffer (copy base map data)
-            std::vector<char> combined_glyphs = glyphs;
-
-            // Overlay any glyph renderables on top of the base map
-            world_->for_each<Transform, GlyphRenderable>(
-                    [&](const Transform&           transform,
-                            const GlyphRenderable& glyph) {
-                        // compute integer tile coords
-                        const auto col_i = static_cast<std::int32_t>(
-                                transform.position.x / TILE_WIDTH);
-                        const auto row_i = static_cast<std::int32_t>(
-                                transform.position.y / TILE_HEIGHT);
-                        if (col_i < 0 || row_i < 0) {
-                            return;
-                        }
-
-                        // switch to unsigned for comparison
-                        const auto col_u = static_cast<size_t>(col_i);
-                        const auto row_u = static_cast<size_t>(row_i);
+            if (!frame_.same_size(cells)) {
+                frame_.resize(cells.cols(), cells.rows());
+            }
 
-                        if (col_u >= cols || row_u >= rows) {
-                            return;
-                        }
+            // Layer 1: actors, stamped serially (a sparse scatter)
+            if (!actor_layer_.same_size(cells)) {
+                actor_layer_.resize(cells.cols(), cells.rows());
+            } else {
+                actor_layer_.clear();
+            }
+            build_actor_layer();
 
-                        // explicit parens to clarify order
-                        const auto index       = (row_u * cols) + col_u;
-                        combined_glyphs[index] = glyph.glyph;
+            // Per row band: copy the base map (layer 0), then compose the
+            // actors over it in SIMD row passes. Bands touch disjoint rows.
+            const size_t cols = cells.cols();
+            jobs_.parallel_for(cells.rows(),
+                    console_rows_per_job(cells.cols()),
+                    [&](const size_t first_row, const size_t last_row) {
+                        frame_.copy_cells(cells,
+                                first_row * cols,
+                                (last_row - first_row) * cols);
+                        frame_.compose_rows(actor_layer_,
+                                static_cast<uint32_t>(first_row),
+                                static_cast<uint32_t>(last_row - first_row));
                     });
+
             // Draw the combined tile map in one pass
-            renderer_->render_console(combined_glyphs.data(), cols, rows);
-            drew_map = true;
+            renderer_->render_console(frame_);
+            drew_map    = true;
+            overlay_row = static_cast<std::int32_t>(frame_.rows());
         }
         if (!drew_map) {
             // No tile map present: render each glyph entity individually
             world_->for_each<Transform, GlyphRenderable>(
                     [&](const Transform&           transform,
                             const GlyphRenderable& glyph) {
-                        const auto col = static_cast<std::int32_t>(
-                                transform.position.x / TILE_WIDTH);
-                        const auto row = static_cast<std::int32_t>(
-                                transform.position.y / TILE_HEIGHT);
+                        const auto col = static_cast<std::int32_t>(std::floor(
+                                transform.position.x / TILE_WIDTH));
+                        const auto row = static_cast<std::int32_t>(std::floor(
+                                transform.position.y / TILE_HEIGHT));
 
                         // build a tiny text batch
                         const std::array text = {glyph.glyph, '\0'};
-                        renderer_->render_text(text.data(), col, row);
+                        renderer_->render_text(
+                                text.data(), col, row, glyph.color);
                     });
         }
     } else {
         // Fallback: render error text if the world is not set
-        renderer_->render_text("Something went wrong with the world!", 1, 1);
+        renderer_->render_text("Something went wrong with the world!",
+                1,
+                1,
+                ERROR_TEXT_COLOR);
+    }
+
+    // Overlay text rarely changes, so it is served from the text cache
+    for (const std::string& line : overlay_lines_) {
+        renderer_->render_text(
+                line.c_str(), 0, overlay_row++, OVERLAY_TEXT_COLOR);
     }
+
+    // UI text goes last so it lands on top of the map
+    renderer_->flush_text();
     graphics_context_.end_frame();
 }
+
+void RenderSystem::build_actor_layer() {
+    const auto cols = actor_layer_.cols();
+    const auto rows = actor_layer_.rows();
+
+    // No CELL_PAINTS_BACKGROUND: actors keep the floor beneath
+    const auto stamp = [&](const uint32_t col, const uint32_t row,
+                               const GlyphRenderable& glyph) {
+        actor_layer_.set_cell_at(col,
+                row,
+                {.glyph = static_cast<uint8_t>(glyph.glyph),
+                        .flags = 0,
+                        .fg    = glyph.color,
+                        .bg    = {}});
+    };
+
+    if (spatial_index_ != nullptr) {
+        // Visit only occupied tiles, so the cost follows the actor count,
+        // not the map size; each occupant costs one sparse glyph lookup
+        const auto* glyphs = world_->find_storage<GlyphRenderable>();
+        if (glyphs == nullptr) {
+            return;
+        }
+        spatial_index_->for_each_occupied(
+                [&](const TileCoord tile, const std::span<const Entity> bucket) {
+                    const auto col = static_cast<uint32_t>(tile.x);
+                    const auto row = static_cast<uint32_t>(tile.y);
+                    if (col >= cols || row >= rows) {
+                        return; // index larger than this map
+                    }
+                    for (const Entity entity : bucket) {
+                        if (const auto* glyph = glyphs->get(entity)) {
+                            stamp(col, row, *glyph);
+                        }
+                    }
+                });
+        return;
+    }
+
+    world_->for_each<Transform, GlyphRenderable>(
+            [&](const Transform& transform, const GlyphRenderable& glyph) {
+                // compute integer tile coords
+                const auto col_i = static_cast<std::int32_t>(
+                        std::floor(transform.position.x / TILE_WIDTH));
+                const auto row_i = static_cast<std::int32_t>(
+                        std::floor(transform.position.y / TILE_HEIGHT));
+                if (col_i < 0 || row_i < 0) {
+                    return;
+                }
+
+                // switch to unsigned for comparison
+                const auto col_u = static_cast<uint32_t>(col_i);
+                const auto row_u = static_cast<uint32_t>(row_i);
+
+                if (col_u >= cols || row_u >= rows) {
+                    return;
+                }
+                stamp(col_u, row_u, glyph);
+            });
+}
@@ -1,21 +1,47 @@
 module;
 #include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 export module Engine.Rendering.Systems.Core;
 
 import Engine.Platform.Sdl; // GraphicsContext (window/GL context)
 import Engine.Ecs.Registry; // ECS Registry
 import Engine.Rendering.RendererInterface; // IRenderer (frontend)
+import Engine.Rendering.Console; // ConsoleBuffer
+import Engine.Jobs.ThreadPool; // ThreadPool (row-band composition)
+import Engine.Spatial.SpatialIndex; // SpatialIndex (actors per tile)
 
 export class RenderSystem {
 public:
     RenderSystem(SdlGlGraphicsContext&      graphics_context,
-            std::unique_ptr<IRenderer> renderer);
+            std::unique_ptr<IRenderer> renderer, ThreadPool& jobs);
     void set_world(Registry& world);
-    void update(float delta_time) const;
+
+    // Tile index of the world's Transforms, kept current by
+    // SpatialIndexSystem. When set, actors are found by walking the occupied
+    // tiles instead of every Transform + GlyphRenderable pair.
+    void set_spatial_index(const SpatialIndex& index);
+    void update(float delta_time);
+
+    // Debug text drawn below the map every frame until replaced; an empty
+    // span hides it
+    void set_overlay(std::span<const std::string> lines);
 
 private:
+    // Stamp glyph renderables into actor_layer_ (sized like the map)
+    void build_actor_layer();
+
     SdlGlGraphicsContext& graphics_context_; // not owned (window/GL context)
     std::unique_ptr<IRenderer> renderer_; // owned rendering backend
     Registry*                  world_ = nullptr; // not owned (ECS registry)
+    const SpatialIndex* spatial_index_ = nullptr; // not owned (tile index)
+    ThreadPool&                jobs_; // not owned (composition bands)
+
+    // Per-frame composition scratch, reused to avoid reallocating
+    ConsoleBuffer frame_;       // base map + layers, what gets drawn
+    ConsoleBuffer actor_layer_; // glyph renderables; glyph 0 = empty
+
+    std::vector<std::string> overlay_lines_;
 };
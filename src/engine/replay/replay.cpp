@@ -0,0 +1,172 @@
+//-----------------------------------------------------------------------------
+// src/engine/replay/replay.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <print>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+module Engine.Replay;
+
+import Engine.Platform.MappedFile;
+
+//-----------------------------------------------------------------------------
+// Module-level constants
+//-----------------------------------------------------------------------------
+static constexpr std::array<char, 4> REPLAY_MAGIC = {'E', 'G', 'R', 'P'};
+
+//-----------------------------------------------------------------------------
+// ReplayRecorder
+//-----------------------------------------------------------------------------
+auto ReplayRecorder::create(const std::string& path)
+        -> std::optional<ReplayRecorder> {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::println(stderr, "Failed to open '{}' for recording", path);
+        return std::nullopt;
+    }
+    ReplayRecorder recorder(file, path);
+    if (!recorder.write(REPLAY_MAGIC.data(), REPLAY_MAGIC.size()) ||
+            !recorder.write(&REPLAY_VERSION, sizeof(REPLAY_VERSION))) {
+        std::println(stderr, "Failed to write replay header to '{}'", path);
+        return std::nullopt;
+    }
+    return recorder;
+}
+
+ReplayRecorder::ReplayRecorder(std::FILE* file, std::string path)
+    : file_(file), path_(std::move(path)) {}
+
+auto ReplayRecorder::record(const InputFrame& frame, const uint64_t state_hash)
+        -> bool {
+    if (failed_) {
+        return false;
+    }
+    const auto event_count = static_cast<uint32_t>(frame.events.size());
+    if (!write(&frame.seed, sizeof(frame.seed)) ||
+            !write(&state_hash, sizeof(state_hash)) ||
+            !write(&event_count, sizeof(event_count)) ||
+            !write(frame.events.data(), event_count * sizeof(InputEvent))) {
+        fail();
+        return false;
+    }
+    ++ticks_;
+    return true;
+}
+
+auto ReplayRecorder::close() -> bool {
+    if (file_ && std::fclose(file_.release()) != 0 && !failed_) {
+        fail();
+    }
+    return !failed_;
+}
+
+auto ReplayRecorder::write(const void* data, const size_t size) -> bool {
+    return size == 0 || std::fwrite(data, 1, size, file_.get()) == size;
+}
+
+void ReplayRecorder::fail() {
+    failed_ = true;
+    std::println(stderr,
+            "Failed to write replay '{}'; recording stopped after {} ticks",
+            path_,
+            ticks_);
+}
+
+//-----------------------------------------------------------------------------
+// Loading
+//-----------------------------------------------------------------------------
+auto load_replay(const std::string& path)
+        -> std::optional<std::vector<ReplayTick>> {
+    const auto file = MappedFile::open(path);
+    if (!file) {
+        return std::nullopt;
+    }
+    const auto bytes  = file->bytes();
+    size_t     offset = 0;
+
+    // Bounds-checked sequential read of a trivially-copyable value
+    const auto read = [&](void* out, const size_t size) {
+        if (bytes.size() - offset < size) {
+            return false;
+        }
+        if (size == 0) {
+            return true; // `out` may be an empty vector's null data()
+        }
+        std::memcpy(out, bytes.data() + offset, size);
+        offset += size;
+        return true;
+    };
+
+    std::array<char, 4> magic{};
+    uint32_t            version = 0;
+    if (!read(magic.data(), magic.size()) || magic != REPLAY_MAGIC ||
+            !read(&version, sizeof(version)) || version != REPLAY_VERSION) {
+        std::println(stderr, "'{}' is not a supported replay", path);
+        return std::nullopt;
+    }
+
+    std::vector<ReplayTick> ticks;
+    while (offset < bytes.size()) {
+        ReplayTick tick;
+        uint32_t   event_count = 0;
+        if (!read(&tick.frame.seed, sizeof(tick.frame.seed)) ||
+                !read(&tick.state_hash, sizeof(tick.state_hash)) ||
+                !read(&event_count, sizeof(event_count)) ||
+                (bytes.size() - offset) / sizeof(InputEvent) < event_count) {
+            // A recording cut short by a crash keeps its complete ticks
+            std::println(stderr,
+                    "Replay '{}' truncated after {} ticks",
+                    path,
+                    ticks.size());
+            break;
+        }
+        tick.frame.events.resize(event_count);
+        read(tick.frame.events.data(), event_count * sizeof(InputEvent));
+        ticks.push_back(std::move(tick));
+    }
+    return ticks;
+}
+
+//-----------------------------------------------------------------------------
+// Driver
+//-----------------------------------------------------------------------------
+auto run_replay(const std::span<const ReplayTick>        ticks,
+        const std::function<void(const InputFrame&)>& step,
+        const std::function<uint64_t()>&               state_hash)
+        -> ReplayResult {
+    using Clock = std::chrono::steady_clock;
+
+    ReplayResult result;
+    for (const auto& [frame, expected_hash] : ticks) {
+        const auto start = Clock::now();
+        step(frame);
+        const auto elapsed_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        Clock::now() - start)
+                        .count());
+
+        result.total_ns += elapsed_ns;
+        result.max_tick_ns = std::max(result.max_tick_ns, elapsed_ns);
+
+        // Hashing is excluded from the timings above
+        if (state_hash() != expected_hash) {
+            result.first_mismatch = result.ticks;
+            ++result.ticks;
+            break;
+        }
+        ++result.ticks;
+    }
+    return result;
+}
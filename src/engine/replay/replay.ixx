@@ -0,0 +1,83 @@
+//-----------------------------------------------------------------------------
+// src/engine/replay/replay.ixx
+// Per-tick input recording and headless, deterministic replay
+//-----------------------------------------------------------------------------
+module;
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+export module Engine.Replay;
+
+import Engine.Input;
+
+//-----------------------------------------------------------------------------
+// File layout
+//-----------------------------------------------------------------------------
+// [magic "EGRP"][version u32]
+// per tick: [seed u64][state hash u64][event count u32][InputEvent * count]
+//-----------------------------------------------------------------------------
+export constexpr uint32_t REPLAY_VERSION = 1;
+
+export struct ReplayTick {
+    InputFrame frame;
+    uint64_t   state_hash{0}; // registry hash after the tick was simulated
+};
+
+// Streams ticks to disk as they are simulated.
+export class ReplayRecorder {
+public:
+    // Factory: opens `path` and writes the header, or returns nullopt on
+    // failure.
+    static auto create(const std::string& path)
+            -> std::optional<ReplayRecorder>;
+
+    // Append one tick. The first failed write (disk full, I/O error) is
+    // reported and stops the recording; the file keeps the complete ticks
+    // before it, which load_replay still reads. Returns false from then on.
+    auto record(const InputFrame& frame, uint64_t state_hash) -> bool;
+
+    // Flush and close, reporting errors deferred by buffering. False if any
+    // write failed over the recording's lifetime.
+    auto close() -> bool;
+
+private:
+    struct FileCloser {
+        void operator()(std::FILE* file) const {
+            std::fclose(file);
+        }
+    };
+
+    ReplayRecorder(std::FILE* file, std::string path);
+    auto write(const void* data, size_t size) -> bool;
+    void fail();
+
+    std::unique_ptr<std::FILE, FileCloser> file_;
+    std::string                            path_;
+    uint64_t                               ticks_{0};
+    bool                                   failed_{false};
+};
+
+export auto load_replay(const std::string& path)
+        -> std::optional<std::vector<ReplayTick>>;
+
+export struct ReplayResult {
+    uint64_t                ticks{0};
+    std::optional<uint64_t> first_mismatch; // tick whose hash diverged
+    uint64_t                total_ns{0};
+    uint64_t                max_tick_ns{0};
+};
+
+// Re-run the recorded ticks back to back (no frame pacing, no rendering),
+// checking the state hash after each one. Stops at the first divergence,
+// since everything after it is meaningless.
+export auto run_replay(std::span<const ReplayTick>             ticks,
+                       const std::function<void(const InputFrame&)>& step,
+                       const std::function<uint64_t()>&        state_hash)
+        -> ReplayResult;
@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// src/engine/replay/state_hasher.ixx
+// Hash of registry state for determinism checks, independent of dense layout
+//-----------------------------------------------------------------------------
+module;
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+export module Engine.Replay.StateHasher;
+
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+
+// FNV-1a over raw bytes; cheap, stable across platforms of equal endianness
+constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ULL;
+constexpr uint64_t FNV_PRIME        = 0x100000001B3ULL;
+
+auto fnv1a(uint64_t hash, const std::span<const std::byte> bytes) -> uint64_t {
+    for (const auto byte : bytes) {
+        hash ^= static_cast<uint64_t>(byte);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+template <typename T> auto fnv1a(const uint64_t hash, const T& value) -> uint64_t {
+    return fnv1a(hash, std::as_bytes(std::span(&value, 1)));
+}
+
+struct IHashedComponent {
+    virtual ~IHashedComponent()                                     = default;
+    virtual auto hash(const Registry& registry, uint64_t seed) -> uint64_t = 0;
+};
+
+template <typename Component>
+class HashedComponent final : public IHashedComponent {
+public:
+    auto hash(const Registry& registry, uint64_t seed) -> uint64_t override {
+        // No storage hashes like an empty one
+        const auto* storage = registry.find_storage<Component>();
+        if (storage == nullptr) {
+            return seed;
+        }
+        const auto components = storage->dense_components();
+        const auto sparse     = storage->sparse_indices();
+
+        // Walk by entity index, not dense order: swap-and-pop and sorting
+        // reshuffle dense arrays without changing the logical state.
+        for (uint32_t index = 0; index < sparse.size(); ++index) {
+            if (sparse[index] >= 0) {
+                seed = fnv1a(seed, index);
+                seed = fnv1a(seed, components[sparse[index]]);
+            }
+        }
+        return seed;
+    }
+};
+
+// Hashes entity bookkeeping plus every registered component type. Components
+// are visited in entity-index order, so two registries holding the same
+// entities and values hash alike however their dense arrays are arranged;
+// the hash itself is sequential FNV-1a, not an order-independent combine.
+// Components are hashed as raw bytes, so register only padding-free types.
+export class StateHasher {
+public:
+    template <typename Component>
+        requires std::is_trivially_copyable_v<Component>
+    void add() {
+        types_.push_back(std::make_unique<HashedComponent<Component>>());
+    }
+
+    [[nodiscard]] auto hash(const Registry& registry) const -> uint64_t {
+        const auto& entities = registry.entity_manager();
+        uint64_t    seed     = fnv1a(FNV_OFFSET_BASIS,
+                std::as_bytes(entities.generations()));
+        seed = fnv1a(seed, std::as_bytes(entities.free_indices()));
+        for (const auto& type : types_) {
+            seed = type->hash(registry, seed);
+        }
+        return seed;
+    }
+
+private:
+    std::vector<std::unique_ptr<IHashedComponent>> types_;
+};
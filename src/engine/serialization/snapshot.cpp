@@ -0,0 +1,221 @@
+//-----------------------------------------------------------------------------
+// src/engine/serialization/snapshot.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <print>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+module Engine.Serialization.Snapshot;
+
+//-----------------------------------------------------------------------------
+// Internal Helpers
+//-----------------------------------------------------------------------------
+static constexpr auto padding_for(const size_t offset) -> size_t {
+    return (SNAPSHOT_ALIGNMENT - (offset % SNAPSHOT_ALIGNMENT)) %
+           SNAPSHOT_ALIGNMENT;
+}
+
+//-----------------------------------------------------------------------------
+// SnapshotWriter
+//-----------------------------------------------------------------------------
+void SnapshotWriter::write_entities(const EntityManager& entities) {
+    write_array(ENTITY_CHUNK_TAG, SnapshotPart::Generations, entities.generations());
+    write_array(ENTITY_CHUNK_TAG, SnapshotPart::FreeIndices, entities.free_indices());
+}
+
+auto SnapshotWriter::save(const std::string& path) const -> bool {
+    const std::string temp_path = path + ".tmp";
+    std::FILE*        file      = std::fopen(temp_path.c_str(), "wb");
+    if (file == nullptr) {
+        std::println(stderr, "Failed to open '{}' for writing", temp_path);
+        return false;
+    }
+
+    constexpr std::array<std::byte, SNAPSHOT_ALIGNMENT> ZEROES{};
+    size_t offset = 0;
+    bool   ok     = true;
+    auto   write  = [&](const void* data, const size_t size) {
+        ok = ok && (size == 0 || std::fwrite(data, 1, size, file) == size);
+        offset += size;
+    };
+
+    const SnapshotHeader header{.magic = SNAPSHOT_MAGIC,
+            .version                   = SNAPSHOT_VERSION,
+            .chunk_count               = static_cast<uint32_t>(chunks_.size()),
+            .reserved                  = 0};
+    write(&header, sizeof(header));
+
+    // Payloads go straight from the live arrays to the file; no staging copy
+    for (const auto& [chunk_header, bytes] : chunks_) {
+        write(&chunk_header, sizeof(chunk_header));
+        write(ZEROES.data(), padding_for(offset));
+        write(bytes.data(), bytes.size());
+    }
+
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::println(stderr, "Failed to write snapshot '{}'", temp_path);
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        std::println(stderr,
+                "Failed to move snapshot into '{}': {}",
+                path,
+                error.message());
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// SnapshotReader
+//-----------------------------------------------------------------------------
+SnapshotReader::SnapshotReader(MappedFile&& file) : file_(std::move(file)) {}
+
+auto SnapshotReader::open(const std::string& path)
+        -> std::optional<SnapshotReader> {
+    auto mapped = MappedFile::open(path);
+    if (!mapped) {
+        return std::nullopt;
+    }
+    SnapshotReader reader(std::move(*mapped));
+    const auto     bytes = reader.file_.bytes();
+
+    SnapshotHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        std::println(stderr, "Snapshot '{}' is truncated", path);
+        return std::nullopt;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) {
+        std::println(stderr,
+                "Snapshot '{}' has unsupported format (version {})",
+                path,
+                header.version);
+        return std::nullopt;
+    }
+
+    // Build the chunk directory; this touches only the small headers
+    size_t offset = sizeof(header);
+    reader.chunks_.reserve(header.chunk_count);
+    for (uint32_t chunk_idx = 0; chunk_idx < header.chunk_count; ++chunk_idx) {
+        ChunkHeader chunk_header{};
+        if (bytes.size() - offset < sizeof(chunk_header)) {
+            std::println(stderr, "Snapshot '{}' is truncated", path);
+            return std::nullopt;
+        }
+        std::memcpy(&chunk_header, bytes.data() + offset, sizeof(chunk_header));
+        offset += sizeof(chunk_header);
+        offset += padding_for(offset);
+
+        const uint64_t payload_size =
+                chunk_header.element_count * chunk_header.element_size;
+        if (offset > bytes.size() ||
+                (chunk_header.element_size != 0 &&
+                        payload_size / chunk_header.element_size !=
+                                chunk_header.element_count) ||
+                bytes.size() - offset < payload_size) {
+            std::println(stderr, "Snapshot '{}' is truncated", path);
+            return std::nullopt;
+        }
+        reader.chunks_.push_back({.header = chunk_header,
+                .bytes = bytes.subspan(offset, static_cast<size_t>(payload_size))});
+        offset += static_cast<size_t>(payload_size);
+    }
+
+    return std::make_optional<SnapshotReader>(std::move(reader));
+}
+
+auto SnapshotReader::read_entities(EntityManager& entities) const -> bool {
+    const auto generations =
+            read_array<uint32_t>(ENTITY_CHUNK_TAG, SnapshotPart::Generations);
+    const auto free_indices =
+            read_array<uint32_t>(ENTITY_CHUNK_TAG, SnapshotPart::FreeIndices);
+    if (!generations || !free_indices) {
+        return false;
+    }
+
+    // A bad free list would hand out an index that is still in use
+    std::vector<bool> freed(generations->size(), false);
+    for (const uint32_t index : *free_indices) {
+        if (index >= freed.size() || freed[index]) {
+            std::println(stderr, "Snapshot free index {} is invalid", index);
+            return false;
+        }
+        freed[index] = true;
+    }
+
+    entities.restore(*generations, *free_indices);
+    return true;
+}
+
+auto SnapshotReader::contains(const uint32_t tag) const -> bool {
+    return std::ranges::any_of(chunks_, [&](const ChunkView& chunk) {
+        return chunk.header.tag == tag;
+    });
+}
+
+auto SnapshotReader::valid_storage(const uint32_t tag,
+        const std::span<const Entity> entities,
+        const std::span<const int32_t> sparse, const EntityManager& manager)
+        -> bool {
+    // Every dense entity is alive and its sparse slot points back at it...
+    for (size_t idx = 0; idx < entities.size(); ++idx) {
+        const Entity entity = entities[idx];
+        if (!manager.is_alive(entity) || entity.index >= sparse.size() ||
+                std::cmp_not_equal(sparse[entity.index], idx)) {
+            std::println(stderr,
+                    "Snapshot chunk {:08x} has a stale or unmapped entity at "
+                    "slot {}",
+                    tag,
+                    idx);
+            return false;
+        }
+    }
+
+    // ...and no other sparse slot points anywhere, in range or not
+    const auto mapped = std::ranges::count_if(
+            sparse, [](const int32_t slot) { return slot >= 0; });
+    if (std::cmp_not_equal(mapped, entities.size())) {
+        std::println(stderr,
+                "Snapshot chunk {:08x} has {} sparse slots for {} components",
+                tag,
+                mapped,
+                entities.size());
+        return false;
+    }
+    return true;
+}
+
+auto SnapshotReader::find(const uint32_t tag, const SnapshotPart part,
+        const size_t element_size) const
+        -> std::optional<std::span<const std::byte>> {
+    for (const auto& [header, bytes] : chunks_) {
+        if (header.tag == tag && header.part == part) {
+            if (header.element_size != element_size) {
+                std::println(stderr,
+                        "Snapshot chunk element size mismatch ({} vs {})",
+                        header.element_size,
+                        element_size);
+                return std::nullopt;
+            }
+            return bytes;
+        }
+    }
+    return std::nullopt;
+}
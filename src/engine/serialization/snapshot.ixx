@@ -0,0 +1,244 @@
+//-----------------------------------------------------------------------------
+// src/engine/serialization/snapshot.ixx
+// Versioned binary world snapshots: raw array chunks, memory-mapped on load
+//-----------------------------------------------------------------------------
+module;
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+export module Engine.Serialization.Snapshot;
+
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+import Engine.Platform.MappedFile;
+
+//-----------------------------------------------------------------------------
+// File layout
+//-----------------------------------------------------------------------------
+// [SnapshotHeader]
+// [ChunkHeader][pad to 16][payload: element_count * element_size bytes] ...
+//
+// Every payload is a raw, trivially-copyable array written straight from the
+// live container, and starts on a 16-byte boundary so the loader can view it
+// in place through the mapping. Chunks are identified by a caller-chosen tag
+// (stable across builds, unlike std::type_index) plus a part.
+//
+// Bump SNAPSHOT_VERSION whenever the layout of anything written changes,
+// including a serialized component's fields; older files are then rejected
+// up front instead of being misread.
+//   1: initial format
+//   2: GlyphRenderable gained an Rgb8 color
+//-----------------------------------------------------------------------------
+export constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+export constexpr auto make_chunk_tag(const char (&name)[5]) -> uint32_t {
+    return static_cast<uint32_t>(static_cast<uint8_t>(name[0])) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(name[1])) << 8U) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(name[2])) << 16U) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(name[3])) << 24U);
+}
+
+export constexpr uint32_t SNAPSHOT_MAGIC     = make_chunk_tag("EGSN");
+export constexpr uint32_t ENTITY_CHUNK_TAG   = make_chunk_tag("ENTS");
+export constexpr size_t   SNAPSHOT_ALIGNMENT = 16;
+
+export enum class SnapshotPart : uint32_t {
+    Data        = 0, // dense component array, tile array, plain values
+    Entities    = 1, // dense Entity array parallel to Data
+    Sparse      = 2, // entity index -> dense index
+    Generations = 3,
+    FreeIndices = 4,
+};
+
+export struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t chunk_count;
+    uint32_t reserved;
+};
+
+export struct ChunkHeader {
+    uint32_t     tag;
+    SnapshotPart part;
+    uint32_t     element_size;
+    uint32_t     reserved;
+    uint64_t     element_count;
+};
+
+template <typename T>
+concept Snapshottable = std::is_trivially_copyable_v<T> &&
+                        alignof(T) <= SNAPSHOT_ALIGNMENT;
+
+//-----------------------------------------------------------------------------
+// Writer: collects views of live arrays, then streams them out in one pass.
+// The registry/containers passed in must stay untouched until save().
+//-----------------------------------------------------------------------------
+export class SnapshotWriter {
+public:
+    template <Snapshottable T>
+    void write_array(uint32_t tag, SnapshotPart part, std::span<const T> values);
+
+    // Copies the value, so temporaries are fine
+    template <Snapshottable T>
+    void write_value(uint32_t tag, SnapshotPart part, const T& value);
+
+    void write_entities(const EntityManager& entities);
+
+    // Dense components, dense entities and the sparse map of storage C.
+    // Writes nothing if the registry never had a C.
+    template <Snapshottable C>
+    void write_components(uint32_t tag, const Registry& registry);
+
+    // Writes to a temporary file and renames it over `path`, so a crash
+    // mid-save never leaves a truncated snapshot behind.
+    [[nodiscard]] auto save(const std::string& path) const -> bool;
+
+private:
+    struct PendingChunk {
+        ChunkHeader                header;
+        std::span<const std::byte> bytes;
+    };
+
+    std::vector<PendingChunk>         chunks_;
+    std::deque<std::vector<std::byte>> owned_; // backing for write_value
+};
+
+//-----------------------------------------------------------------------------
+// Reader: maps the file and hands out typed views of the payloads.
+//-----------------------------------------------------------------------------
+export class SnapshotReader {
+public:
+    // Factory: maps and validates the file, or returns nullopt on failure.
+    static auto open(const std::string& path) -> std::optional<SnapshotReader>;
+
+    // View of a chunk's payload inside the mapping (valid while the reader
+    // lives), or nullopt if missing or written with a different element size.
+    template <Snapshottable T>
+    [[nodiscard]] auto read_array(uint32_t tag, SnapshotPart part) const
+            -> std::optional<std::span<const T>>;
+
+    template <Snapshottable T>
+    [[nodiscard]] auto read_value(uint32_t tag, SnapshotPart part) const
+            -> std::optional<T>;
+
+    // True if any chunk carries `tag`
+    [[nodiscard]] auto contains(uint32_t tag) const -> bool;
+
+    // Restores generations and the free list; fails on free indices that are
+    // out of range or listed twice
+    auto read_entities(EntityManager& entities) const -> bool;
+
+    // Replaces storage C with the snapshot's arrays (one bulk copy each),
+    // after checking that the sparse map and dense entities agree and that
+    // every entity is alive in `registry`. Read entities first. A snapshot
+    // without C leaves the storage empty.
+    template <Snapshottable C>
+    auto read_components(uint32_t tag, Registry& registry) const -> bool;
+
+private:
+    struct ChunkView {
+        ChunkHeader                header;
+        std::span<const std::byte> bytes;
+    };
+
+    explicit SnapshotReader(MappedFile&& file);
+    // Sparse map and dense entities must be exact inverses, over live entities
+    static auto valid_storage(uint32_t tag, std::span<const Entity> entities,
+            std::span<const int32_t> sparse, const EntityManager& manager)
+            -> bool;
+    [[nodiscard]] auto find(uint32_t tag, SnapshotPart part, size_t element_size)
+            const -> std::optional<std::span<const std::byte>>;
+
+    MappedFile             file_;
+    std::vector<ChunkView> chunks_;
+};
+
+//------------------------------------------------------------------------------
+// Definitions of templated methods (must appear in the .ixx interface)
+//------------------------------------------------------------------------------
+template <Snapshottable T>
+void SnapshotWriter::write_array(const uint32_t tag, const SnapshotPart part,
+        const std::span<const T> values) {
+    chunks_.push_back({.header = {.tag           = tag,
+                               .part          = part,
+                               .element_size  = sizeof(T),
+                               .reserved      = 0,
+                               .element_count = values.size()},
+            .bytes = std::as_bytes(values)});
+}
+
+template <Snapshottable T>
+void SnapshotWriter::write_value(const uint32_t tag, const SnapshotPart part,
+        const T& value) {
+    auto& bytes = owned_.emplace_back(sizeof(T));
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    chunks_.push_back({.header = {.tag           = tag,
+                               .part          = part,
+                               .element_size  = sizeof(T),
+                               .reserved      = 0,
+                               .element_count = 1},
+            .bytes = bytes});
+}
+
+template <Snapshottable C>
+void SnapshotWriter::write_components(const uint32_t tag,
+        const Registry& registry) {
+    const auto* storage = registry.find_storage<C>();
+    if (storage == nullptr) {
+        return;
+    }
+    write_array(tag, SnapshotPart::Data, storage->dense_components());
+    write_array(tag,
+            SnapshotPart::Entities,
+            std::span<const Entity>(storage->entities_with_component()));
+    write_array(tag, SnapshotPart::Sparse, storage->sparse_indices());
+}
+
+template <Snapshottable T>
+auto SnapshotReader::read_array(const uint32_t tag, const SnapshotPart part)
+        const -> std::optional<std::span<const T>> {
+    const auto bytes = find(tag, part, sizeof(T));
+    if (!bytes) {
+        return std::nullopt;
+    }
+    // Payloads are 16-byte aligned inside a page-aligned mapping, so the
+    // array can be viewed in place without copying.
+    return std::span<const T>(reinterpret_cast<const T*>(bytes->data()),
+            bytes->size() / sizeof(T));
+}
+
+template <Snapshottable T>
+auto SnapshotReader::read_value(const uint32_t tag, const SnapshotPart part)
+        const -> std::optional<T> {
+    const auto values = read_array<T>(tag, part);
+    if (!values || values->size() != 1) {
+        return std::nullopt;
+    }
+    return values->front();
+}
+
+template <Snapshottable C>
+auto SnapshotReader::read_components(const uint32_t tag, Registry& registry)
+        const -> bool {
+    if (!contains(tag)) {
+        return true; // no C when saved
+    }
+    const auto components = read_array<C>(tag, SnapshotPart::Data);
+    const auto entities   = read_array<Entity>(tag, SnapshotPart::Entities);
+    const auto sparse     = read_array<int32_t>(tag, SnapshotPart::Sparse);
+    if (!components || !entities || !sparse ||
+            components->size() != entities->size() ||
+            !valid_storage(
+                    tag, *entities, *sparse, registry.entity_manager())) {
+        return false;
+    }
+    registry.adopt<C>(*components, *entities, *sparse);
+    return true;
+}
@@ -0,0 +1,186 @@
+//-----------------------------------------------------------------------------
+// src/engine/spatial/spatial_index.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+module Engine.Spatial.SpatialIndex;
+
+SpatialIndex::SpatialIndex(const uint32_t cols, const uint32_t rows)
+    : cols_(cols), rows_(rows), cells_(static_cast<size_t>(cols) * rows),
+      occupied_slot_(cells_.size(), NO_CELL) {}
+
+void SpatialIndex::insert(const Entity entity, const TileCoord tile) {
+    move(entity, tile);
+}
+
+void SpatialIndex::move(const Entity entity, const TileCoord tile) {
+    if (entity.index >= entity_cell_.size()) {
+        entity_cell_.resize(entity.index + 1, NO_CELL);
+        entity_slot_.resize(entity.index + 1, 0);
+    }
+
+    const auto new_cell = cell_index(tile);
+    const auto old_cell = entity_cell_[entity.index];
+
+    // Most frames most entities don't cross a tile boundary; make that free.
+    if (new_cell == old_cell) {
+        if (new_cell != NO_CELL) {
+            // Keep the stored generation current if the index slot was
+            // recycled for a new entity standing on the same tile.
+            cells_[new_cell][entity_slot_[entity.index]] = entity;
+        }
+        return;
+    }
+
+    unlink(entity.index);
+    if (new_cell == NO_CELL) {
+        return;
+    }
+
+    auto& bucket = cells_[new_cell];
+    if (bucket.empty()) {
+        occupied_slot_[new_cell] = static_cast<int32_t>(occupied_.size());
+        occupied_.push_back(static_cast<uint32_t>(new_cell));
+    }
+    entity_cell_[entity.index] = new_cell;
+    entity_slot_[entity.index] = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(entity);
+}
+
+void SpatialIndex::remove(const Entity entity) {
+    // A stale handle must not evict whoever now holds its recycled index
+    if (!contains(entity)) {
+        return;
+    }
+    unlink(entity.index);
+}
+
+void SpatialIndex::clear() {
+    for (const uint32_t cell : occupied_) {
+        cells_[cell].clear();
+        occupied_slot_[cell] = NO_CELL;
+    }
+    occupied_.clear();
+    std::ranges::fill(entity_cell_, NO_CELL);
+}
+
+auto SpatialIndex::contains(const Entity entity) const -> bool {
+    if (entity.index >= entity_cell_.size()) {
+        return false;
+    }
+    const auto cell = entity_cell_[entity.index];
+    return cell != NO_CELL &&
+           cells_[cell][entity_slot_[entity.index]].generation ==
+                   entity.generation;
+}
+
+auto SpatialIndex::in_bounds(const TileCoord tile) const -> bool {
+    return tile.x >= 0 && tile.y >= 0 &&
+           static_cast<uint32_t>(tile.x) < cols_ &&
+           static_cast<uint32_t>(tile.y) < rows_;
+}
+
+auto SpatialIndex::cols() const -> uint32_t {
+    return cols_;
+}
+
+auto SpatialIndex::rows() const -> uint32_t {
+    return rows_;
+}
+
+auto SpatialIndex::at(const TileCoord tile) const -> std::span<const Entity> {
+    const auto cell = cell_index(tile);
+    if (cell == NO_CELL) {
+        return {};
+    }
+    return cells_[cell];
+}
+
+auto SpatialIndex::query_rect(const TileRect rect, std::span<Entity> out) const
+        -> std::span<Entity> {
+    size_t count = 0;
+    const auto clipped = clip(rect);
+    for (int32_t y_pos = clipped.min.y; y_pos <= clipped.max.y; ++y_pos) {
+        for (int32_t x_pos = clipped.min.x; x_pos <= clipped.max.x; ++x_pos) {
+            for (const auto entity : at({.x = x_pos, .y = y_pos})) {
+                if (count == out.size()) {
+                    return out;
+                }
+                out[count++] = entity;
+            }
+        }
+    }
+    return out.first(count);
+}
+
+auto SpatialIndex::query_radius(const TileCoord center, const uint32_t radius,
+        std::span<Entity> out) const -> std::span<Entity> {
+    const auto reach = static_cast<int32_t>(radius);
+    const auto clipped =
+            clip({.min = {.x = center.x - reach, .y = center.y - reach},
+                    .max = {.x = center.x + reach, .y = center.y + reach}});
+    const int64_t radius_sq = static_cast<int64_t>(reach) * reach;
+
+    size_t count = 0;
+    for (int32_t y_pos = clipped.min.y; y_pos <= clipped.max.y; ++y_pos) {
+        const int64_t d_y = y_pos - center.y;
+        for (int32_t x_pos = clipped.min.x; x_pos <= clipped.max.x; ++x_pos) {
+            // Compare tile centres with a Euclidean test on squared distance
+            const int64_t d_x = x_pos - center.x;
+            if ((d_x * d_x) + (d_y * d_y) > radius_sq) {
+                continue;
+            }
+            for (const auto entity : at({.x = x_pos, .y = y_pos})) {
+                if (count == out.size()) {
+                    return out;
+                }
+                out[count++] = entity;
+            }
+        }
+    }
+    return out.first(count);
+}
+
+auto SpatialIndex::cell_index(const TileCoord tile) const -> int32_t {
+    if (!in_bounds(tile)) {
+        return NO_CELL;
+    }
+    return static_cast<int32_t>((static_cast<uint32_t>(tile.y) * cols_) +
+                                static_cast<uint32_t>(tile.x));
+}
+
+auto SpatialIndex::clip(const TileRect rect) const -> TileRect {
+    // An empty grid yields max < min, so every loop above runs zero times
+    return {.min = {.x = std::max(rect.min.x, 0), .y = std::max(rect.min.y, 0)},
+            .max = {.x = std::min(rect.max.x, static_cast<int32_t>(cols_) - 1),
+                    .y = std::min(
+                            rect.max.y, static_cast<int32_t>(rows_) - 1)}};
+}
+
+void SpatialIndex::unlink(const uint32_t entity_index) {
+    const auto cell = entity_cell_[entity_index];
+    if (cell == NO_CELL) {
+        return;
+    }
+
+    // Swap-and-pop within the bucket, fixing up the slot of the moved entity
+    auto&      bucket = cells_[cell];
+    const auto slot   = entity_slot_[entity_index];
+    bucket[slot]      = bucket.back();
+    entity_slot_[bucket[slot].index] = slot;
+    bucket.pop_back();
+    entity_cell_[entity_index] = NO_CELL;
+
+    if (bucket.empty()) {
+        // Same swap-and-pop on the occupied list
+        const auto list_slot = static_cast<size_t>(occupied_slot_[cell]);
+        occupied_[list_slot] = occupied_.back();
+        occupied_slot_[occupied_[list_slot]] = static_cast<int32_t>(list_slot);
+        occupied_.pop_back();
+        occupied_slot_[cell] = NO_CELL;
+    }
+}
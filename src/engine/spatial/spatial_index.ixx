@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// src/engine/spatial/spatial_index.ixx
+// Uniform tile-cell grid answering "what is at / near this tile" queries
+//-----------------------------------------------------------------------------
+module;
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module Engine.Spatial.SpatialIndex;
+
+import Engine.Ecs.Entity;
+
+export struct TileCoord {
+    int32_t x;
+    int32_t y;
+};
+
+// Inclusive tile rectangle [min, max] on both axes.
+export struct TileRect {
+    TileCoord min;
+    TileCoord max;
+};
+
+// One bucket per map tile. Each entity lives in at most one bucket, and we
+// remember its bucket and slot so moves and removals are O(1) swap-and-pops.
+// Non-empty buckets are also listed, so walking every occupant costs the
+// number of occupied tiles rather than the map size.
+// Queries never allocate: point queries hand back the bucket itself, area
+// queries fill a caller-provided scratch span.
+export class SpatialIndex {
+public:
+    SpatialIndex(uint32_t cols, uint32_t rows);
+
+    // Add, relocate or drop an entity. Out-of-bounds coordinates remove the
+    // entity from the index (it can't be found by any query anyway). Moving
+    // a recycled index replaces the previous occupant; remove() and
+    // contains() match the generation too, so stale handles are ignored.
+    void insert(Entity entity, TileCoord tile);
+    void move(Entity entity, TileCoord tile);
+    void remove(Entity entity);
+    void clear();
+
+    [[nodiscard]] auto contains(Entity entity) const -> bool;
+    [[nodiscard]] auto in_bounds(TileCoord tile) const -> bool;
+    [[nodiscard]] auto cols() const -> uint32_t;
+    [[nodiscard]] auto rows() const -> uint32_t;
+
+    // Entities standing on a single tile (empty span if out of bounds).
+    // The span is invalidated by the next insert/move/remove.
+    [[nodiscard]] auto at(TileCoord tile) const -> std::span<const Entity>;
+
+    // Copy entities inside the rect / radius into `out`, returning the filled
+    // prefix. If the result is as large as `out`, there may be more matches.
+    auto query_rect(TileRect rect, std::span<Entity> out) const
+            -> std::span<Entity>;
+    auto query_radius(TileCoord center, uint32_t radius,
+                      std::span<Entity> out) const -> std::span<Entity>;
+
+    // Visit every entity inside the rect without any intermediate buffer.
+    template <typename Func>
+    void for_each_in_rect(TileRect rect, Func func) const;
+
+    // Visit func(tile, bucket) for each tile with at least one entity, in no
+    // particular order. Do not insert/move/remove from inside func.
+    template <typename Func> void for_each_occupied(Func func) const;
+
+private:
+    static constexpr int32_t NO_CELL = -1;
+
+    [[nodiscard]] auto cell_index(TileCoord tile) const -> int32_t;
+    [[nodiscard]] auto clip(TileRect rect) const -> TileRect;
+    void               unlink(uint32_t entity_index);
+
+    uint32_t cols_{};
+    uint32_t rows_{};
+
+    std::vector<std::vector<Entity>> cells_;        // bucket per tile
+    std::vector<uint32_t>            occupied_;     // cells with occupants
+    std::vector<int32_t>             occupied_slot_; // by cell, or NO_CELL
+    std::vector<int32_t>             entity_cell_;  // by Entity::index
+    std::vector<uint32_t>            entity_slot_;  // position in bucket
+};
+
+//------------------------------------------------------------------------------
+// Definitions of templated methods (must appear in the .ixx interface)
+//------------------------------------------------------------------------------
+template <typename Func>
+void SpatialIndex::for_each_in_rect(const TileRect rect, Func func) const {
+    const auto clipped = clip(rect);
+    for (int32_t y_pos = clipped.min.y; y_pos <= clipped.max.y; ++y_pos) {
+        for (int32_t x_pos = clipped.min.x; x_pos <= clipped.max.x; ++x_pos) {
+            for (const auto entity : at({.x = x_pos, .y = y_pos})) {
+                func(entity);
+            }
+        }
+    }
+}
+
+template <typename Func> void SpatialIndex::for_each_occupied(Func func) const {
+    for (const uint32_t cell : occupied_) {
+        func(TileCoord{.x = static_cast<int32_t>(cell % cols_),
+                     .y = static_cast<int32_t>(cell / cols_)},
+                std::span<const Entity>(cells_[cell]));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+//-----------------------------------------------------------------------------
+// src/engine/spatial/systems/spatial_index_system.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+module Engine.Spatial.Systems.SpatialIndex;
+
+import Engine.Config.TileConfig;
+import Engine.Physics.Components.Transform;
+
+SpatialIndexSystem::SpatialIndexSystem(SpatialIndex& index) : index_(index) {}
+
+void SpatialIndexSystem::update(Registry& registry) {
+    const auto* storage = registry.find_storage<Transform>();
+    if (storage == nullptr) {
+        since_ = registry.current_tick();
+        return;
+    }
+
+    // 1) Drop what went away. Removals come first: a Transform removed and
+    //    re-added in the window is stamped again and re-bucketed below.
+    //    Without a complete log, rebuild from every Transform.
+    const auto removals = since_ == 0 ? std::nullopt
+                                      : storage->removals_since(since_);
+    uint32_t   changed  = since_;
+    if (removals) {
+        for (const StorageRemoval& removal : *removals) {
+            index_.remove(removal.entity);
+        }
+    } else {
+        index_.clear();
+        changed = 0;
+    }
+
+    // 2) Re-bucket every Transform stamped in the window (no-op if its tile
+    //    is unchanged). Inclusive, so writes later in the tick of the last
+    //    update are not missed. Floor, not truncate: x in (-TILE_WIDTH, 0)
+    //    is tile -1, off the map.
+    const auto transforms = storage->dense_components();
+    const auto entities   = storage->dense_entities();
+    const auto versions   = storage->versions();
+    for (size_t idx = 0; idx < entities.size(); ++idx) {
+        if (versions[idx] < changed) {
+            continue;
+        }
+        const auto&     position = transforms[idx].position;
+        const TileCoord tile{
+                .x = static_cast<int32_t>(std::floor(position.x / TILE_WIDTH)),
+                .y = static_cast<int32_t>(std::floor(position.y / TILE_HEIGHT))};
+        index_.move(entities[idx], tile);
+    }
+
+    since_ = registry.current_tick();
+}
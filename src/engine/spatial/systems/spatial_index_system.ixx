@@ -0,0 +1,27 @@
+//-----------------------------------------------------------------------------
+// src/engine/spatial/systems/spatial_index_system.ixx
+//-----------------------------------------------------------------------------
+module;
+#include <cstdint>
+
+export module Engine.Spatial.Systems.SpatialIndex;
+
+import Engine.Ecs.Registry;
+import Engine.Ecs.System;
+import Engine.Spatial.SpatialIndex;
+
+// Keeps a SpatialIndex in sync with every entity's Transform. Each update
+// re-buckets only the Transforms stamped since the previous one, after
+// dropping the entities whose Transform was removed (or who were destroyed)
+// in that window, as logged by the storage. Falling more than
+// REMOVAL_LOG_TICKS behind, or a storage replaced wholesale, costs one full
+// rebuild.
+export class SpatialIndexSystem final : public ISystem {
+public:
+    explicit SpatialIndexSystem(SpatialIndex& index);
+    void update(Registry& registry) override;
+
+private:
+    SpatialIndex& index_; // not owned
+    uint32_t      since_{0}; // tick of the last update; 0 = never synced
+};
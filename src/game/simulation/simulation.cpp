@@ -0,0 +1,87 @@
+//-----------------------------------------------------------------------------
+// src/game/simulation/simulation.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+module Game.Simulation;
+
+import Engine.Config.TileConfig;
+import Engine.Physics.Components.Transform;
+
+Simulation::Simulation(Registry& world, const Dungeon& dungeon,
+        const Entity player)
+    : world_(world), dungeon_(dungeon), player_(player) {}
+
+void Simulation::step(const InputFrame& frame) {
+    rng_.reseed(frame.seed);
+
+    for (const auto& event : frame.events) {
+        if (event.type == InputEventType::Quit) {
+            quit_requested_ = true;
+            continue;
+        }
+        if (event.type != InputEventType::KeyDown) {
+            continue;
+        }
+        switch (event.key) {
+        case Key::Up:
+            try_move_player(0, -1);
+            break;
+        case Key::Down:
+            try_move_player(0, 1);
+            break;
+        case Key::Left:
+            try_move_player(-1, 0);
+            break;
+        case Key::Right:
+            try_move_player(1, 0);
+            break;
+        case Key::Escape:
+            quit_requested_ = true;
+            break;
+        default:
+            break;
+        }
+    }
+    ++ticks_;
+}
+
+auto Simulation::quit_requested() const -> bool {
+    return quit_requested_;
+}
+
+auto Simulation::ticks() const -> uint64_t {
+    return ticks_;
+}
+
+auto Simulation::rng() -> Rng& {
+    return rng_;
+}
+
+void Simulation::try_move_player(const int32_t delta_x, const int32_t delta_y) {
+    if (!world_.has_component<Transform>(player_)) {
+        return;
+    }
+    const auto& position =
+            std::as_const(world_).get_component<Transform>(player_).position;
+    const auto  target_x =
+            static_cast<int32_t>(position.x / TILE_WIDTH) + delta_x;
+    const auto target_y =
+            static_cast<int32_t>(position.y / TILE_HEIGHT) + delta_y;
+
+    if (target_x < 0 || target_y < 0 ||
+            static_cast<size_t>(target_x) >= dungeon_.width() ||
+            static_cast<size_t>(target_y) >= dungeon_.height() ||
+            dungeon_.tile_at(static_cast<size_t>(target_x),
+                    static_cast<size_t>(target_y)) == TileType::Wall) {
+        return;
+    }
+
+    // Whole-tile positions: exact in float, so replays hash identically
+    auto& transform      = world_.patch<Transform>(player_);
+    transform.position.x = static_cast<float>(target_x) * TILE_WIDTH;
+    transform.position.y = static_cast<float>(target_y) * TILE_HEIGHT;
+}
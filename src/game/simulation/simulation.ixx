@@ -0,0 +1,40 @@
+//-----------------------------------------------------------------------------
+// src/game/simulation/simulation.ixx
+// Fixed-tick gameplay step driven only by an InputFrame, so that recording
+// the frames is enough to reproduce a session
+//-----------------------------------------------------------------------------
+module;
+#include <cstdint>
+
+export module Game.Simulation;
+
+import Engine.Core;
+import Engine.Ecs.Registry;
+import Engine.Ecs.Entity;
+import Engine.Input;
+import Game.World.Dungeon;
+
+export class Simulation {
+public:
+    Simulation(Registry& world, const Dungeon& dungeon, Entity player);
+
+    // Advance one tick. Must not read clocks, global RNGs or platform state;
+    // everything it needs arrives in `frame`.
+    void step(const InputFrame& frame);
+
+    [[nodiscard]] auto quit_requested() const -> bool;
+    [[nodiscard]] auto ticks() const -> uint64_t;
+
+    // Reseeded from each frame; gameplay randomness must come from here
+    auto rng() -> Rng&;
+
+private:
+    void try_move_player(int32_t delta_x, int32_t delta_y);
+
+    Registry&      world_;
+    const Dungeon& dungeon_;
+    Entity         player_;
+    Rng            rng_;
+    uint64_t       ticks_{0};
+    bool           quit_requested_{false};
+};
@@ -2,12 +2,22 @@
 // dungeon.cpp
 //-----------------------------------------------------------------------------
 module;
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <cstddef>
+#include <span>
 #include <utility>
 
 module Game.World.Dungeon;
 
+//-----------------------------------------------------------------------------
+// Module-level constants
+//-----------------------------------------------------------------------------
+// Past this many disjoint spans, one whole-map span is cheaper to track and
+// to re-translate than the list.
+static constexpr size_t MAX_DIRTY_SPANS = 256;
+
 Dungeon::Dungeon(const DungeonSize dimensions)
     : width_(dimensions.width), height_(dimensions.height),
       tiles_(dimensions.width * dimensions.height, TileType::Unknown) {}
@@ -22,6 +32,7 @@ void Dungeon::generate() {
                                                            : TileType::Floor;
         }
     }
+    mark_dirty(0, tiles_.size());
 }
 
 auto Dungeon::width() const -> size_t {
@@ -39,3 +50,62 @@ auto Dungeon::tile_at(const size_t x_pos, const size_t y_pos) const
     }
     return tiles_[(y_pos * width_) + x_pos];
 }
+
+auto Dungeon::tiles() const -> std::span<const TileType> {
+    return tiles_;
+}
+
+void Dungeon::assign_tiles(const std::span<const TileType> tiles) {
+    assert(tiles.size() == tiles_.size() && "Tile count must match dimensions");
+    tiles_.assign(tiles.begin(), tiles.end());
+    mark_dirty(0, tiles_.size());
+}
+
+void Dungeon::set_tile(const size_t x_pos, const size_t y_pos,
+        const TileType tile) {
+    if (x_pos >= width_ || y_pos >= height_) {
+        return;
+    }
+    const size_t index = (y_pos * width_) + x_pos;
+    if (tiles_[index] == tile) {
+        return;
+    }
+    tiles_[index] = tile;
+    mark_dirty(index, 1);
+}
+
+auto Dungeon::dirty_spans() const -> std::span<const TileSpan> {
+    return dirty_;
+}
+
+void Dungeon::clear_dirty() {
+    dirty_.clear();
+}
+
+void Dungeon::mark_dirty(const size_t first, const size_t count) {
+    if (count == tiles_.size()) {
+        dirty_.assign(1, {.first = 0, .count = count});
+        return;
+    }
+
+    // Extend the last span when the edit touches or overlaps it
+    if (!dirty_.empty()) {
+        auto&        last = dirty_.back();
+        const size_t end  = last.first + last.count;
+        if (first >= last.first && first <= end) {
+            last.count = std::max(end, first + count) - last.first;
+            return;
+        }
+        if (first + count == last.first) {
+            last.first = first;
+            last.count += count;
+            return;
+        }
+    }
+
+    if (dirty_.size() >= MAX_DIRTY_SPANS) {
+        dirty_.assign(1, {.first = 0, .count = tiles_.size()});
+        return;
+    }
+    dirty_.push_back({.first = first, .count = count});
+}
@@ -3,6 +3,7 @@
 //-----------------------------------------------------------------------------
 module;
 #include <cstdint>
+#include <span>
 #include <vector>
 
 export module Game.World.Dungeon;
@@ -19,6 +20,13 @@ export enum class TileType : int8_t {
     Door    = 2   // Interactive tile that can be opened/closed
 };
 
+// Row-major range of tiles [first, first + count) changed since the last
+// clear_dirty()
+export struct TileSpan {
+    size_t first;
+    size_t count;
+};
+
 export class Dungeon {
 public:
     explicit Dungeon(DungeonSize dimensions);
@@ -31,8 +39,27 @@ public:
     [[nodiscard]] auto height() const -> size_t;
     [[nodiscard]] auto tile_at(size_t x_pos, size_t y_pos) const -> TileType;
 
+    // Whole row-major tile grid (width * height)
+    [[nodiscard]] auto tiles() const -> std::span<const TileType>;
+
+    // Overwrite the grid wholesale; `tiles` must hold width * height entries
+    void assign_tiles(std::span<const TileType> tiles);
+
+    // Change one tile (doors, destructible terrain); out-of-bounds is ignored
+    void set_tile(size_t x_pos, size_t y_pos, TileType tile);
+
+    // Edited ranges for incremental consumers (e.g. the tile map). An edit
+    // that touches or overlaps the most recent span extends it, so a run of
+    // adjacent edits becomes one span; any other edit adds a span, even on a
+    // row that already has one. Spans may overlap.
+    [[nodiscard]] auto dirty_spans() const -> std::span<const TileSpan>;
+    void               clear_dirty();
+
 private:
+    void mark_dirty(size_t first, size_t count);
+
     size_t width_{};
     size_t height_{};
     std::vector<TileType> tiles_;
+    std::vector<TileSpan> dirty_;
 };
\ No newline at end of file
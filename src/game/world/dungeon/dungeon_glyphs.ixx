@@ -1,8 +1,13 @@
+module;
+#include <cstdint>
+
 export module Game.World.Dungeon.Glyphs;
 
+import Engine.Core;
+import Engine.Rendering.Console;
 import Game.World.Dungeon;
 
-export inline auto glyph_for_tile(const TileType tile) -> char {
+export constexpr auto glyph_for_tile(const TileType tile) -> char {
     switch (tile) {
     case TileType::Floor:
         return '.';
@@ -13,4 +18,39 @@ export inline auto glyph_for_tile(const TileType tile) -> char {
     default:
         return ' ';
     }
-}
\ No newline at end of file
+}
+
+// Base-layer console cell for a tile: glyph plus its colors
+export constexpr auto cell_for_tile(const TileType tile) -> ConsoleCell {
+    constexpr Rgb8 FLOOR_BG{.r = 26, .g = 26, .b = 30};
+
+    const auto glyph = static_cast<uint8_t>(glyph_for_tile(tile));
+    switch (tile) {
+    case TileType::Floor:
+        return {.glyph = glyph,
+                .flags = CELL_PAINTS_BACKGROUND,
+                .fg    = {.r = 90, .g = 90, .b = 100},
+                .bg    = FLOOR_BG};
+    case TileType::Wall:
+        return {.glyph = glyph,
+                .flags = CELL_PAINTS_BACKGROUND,
+                .fg    = {.r = 170, .g = 160, .b = 140},
+                .bg    = {.r = 60, .g = 52, .b = 44}};
+    case TileType::Door:
+        return {.glyph = glyph,
+                .flags = CELL_PAINTS_BACKGROUND,
+                .fg    = {.r = 200, .g = 150, .b = 60},
+                .bg    = FLOOR_BG};
+    default:
+        return {.glyph = glyph,
+                .flags = CELL_PAINTS_BACKGROUND,
+                .fg    = {},
+                .bg    = {}};
+    }
+}
+
+// cell_for_tile for every possible TileType byte, built at compile time.
+// Index with the tile's raw byte (Unknown = -1 lands on 0xFF).
+export constexpr CellLut TILE_CELL_LUT = make_cell_lut([](const uint8_t key) {
+    return cell_for_tile(static_cast<TileType>(static_cast<int8_t>(key)));
+});
\ No newline at end of file
@@ -1,37 +1,66 @@
 module;
-#include <vector>
-#include <print>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 
 export module Game.World.Dungeon.Systems.DungeonToTileMap;
 
+import Engine.Ecs.Entity;
 import Engine.Ecs.Registry;
+import Engine.Ecs.System;
 import Engine.Rendering.Components.TileMap;
+import Engine.Rendering.Console;
 import Game.World.Dungeon;
 import Game.World.Dungeon.Glyphs;
 
-export class DungeonToTileMapSystem {
+// Mirrors the dungeon into a TileMap entity. initialize() builds the map;
+// update() re-translates only the tile spans edited since the last call, so
+// a door opening costs one cell and a blast crater a few rows.
+export class DungeonToTileMapSystem final : public ISystem {
 public:
     explicit DungeonToTileMapSystem(Dungeon& dungeon)
         : dungeon_(dungeon) {}
 
-    void initialize(Registry& world) const {
+    void initialize(Registry& world) {
         const uint32_t cols = static_cast<uint32_t>(dungeon_.width());
         const uint32_t rows = static_cast<uint32_t>(dungeon_.height());
 
-        std::vector<char> glyphs;
-        glyphs.reserve(cols * rows);
+        entity_ = world.create_entity();
+        auto& cells = world.add_component<TileMap>(*entity_).cells;
+        cells.resize(cols, rows);
+        cells.translate_cells(tile_keys(0, cells.cell_count()), TILE_CELL_LUT, 0);
+        dungeon_.clear_dirty();
+    }
 
-        for (size_t y = 0; y < rows; ++y) {
-            for (size_t x = 0; x < cols; ++x) {
-                const auto tile = dungeon_.tile_at(x, y);
-                glyphs.push_back(glyph_for_tile(tile));
-            }
+    void update(Registry& world) override {
+        const auto spans = dungeon_.dirty_spans();
+        if (!entity_ || spans.empty()) {
+            return;
         }
 
-        const auto entity = world.create_entity();
-        world.add_component<TileMap>(entity, std::move(glyphs), cols, rows);
+        auto& cells = world.get_component<TileMap>(*entity_).cells;
+        if (cells.cols() != dungeon_.width() || cells.rows() != dungeon_.height()) {
+            // Dungeon was replaced with a different size: rebuild in place
+            cells.resize(static_cast<uint32_t>(dungeon_.width()),
+                         static_cast<uint32_t>(dungeon_.height()));
+            cells.translate_cells(tile_keys(0, cells.cell_count()), TILE_CELL_LUT, 0);
+        } else {
+            for (const auto& [first, count] : spans) {
+                cells.translate_cells(tile_keys(first, count), TILE_CELL_LUT, first);
+            }
+        }
+        dungeon_.clear_dirty();
     }
 
 private:
-    Dungeon& dungeon_;
-};
+    // Raw TileType bytes, the LUT's keys
+    [[nodiscard]] auto tile_keys(const size_t first, const size_t count) const
+            -> std::span<const uint8_t> {
+        const auto tiles = dungeon_.tiles().subspan(first, count);
+        return {reinterpret_cast<const uint8_t*>(tiles.data()), tiles.size()};
+    }
+
+    Dungeon&              dungeon_;
+    std::optional<Entity> entity_;
+};
\ No newline at end of file
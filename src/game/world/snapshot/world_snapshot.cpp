@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// src/game/world/snapshot/world_snapshot.cpp
+//-----------------------------------------------------------------------------
+module;
+#include <cstdint>
+#include <print>
+#include <string>
+#include <utility>
+
+module Game.World.Snapshot;
+
+import Engine.Serialization.Snapshot;
+import Engine.Physics.Components.Transform;
+import Engine.Physics.Components.Velocity;
+import Engine.Physics.Components.Collider;
+import Engine.Rendering.Components.GlyphRenderable;
+
+//-----------------------------------------------------------------------------
+// Chunk tags: stable on disk, never reuse or renumber
+//-----------------------------------------------------------------------------
+static constexpr uint32_t TRANSFORM_TAG        = make_chunk_tag("XFRM");
+static constexpr uint32_t VELOCITY_TAG         = make_chunk_tag("VELO");
+static constexpr uint32_t COLLIDER_TAG         = make_chunk_tag("COLL");
+static constexpr uint32_t GLYPH_RENDERABLE_TAG = make_chunk_tag("GLYR");
+static constexpr uint32_t DUNGEON_TILES_TAG    = make_chunk_tag("DTIL");
+static constexpr uint32_t DUNGEON_SIZE_TAG     = make_chunk_tag("DSIZ");
+
+struct DungeonExtent {
+    uint64_t width;
+    uint64_t height;
+};
+
+// Components are stored as raw bytes; a layout change here needs a
+// SNAPSHOT_VERSION bump (and then an update of these sizes)
+static_assert(sizeof(Transform) == 8 && sizeof(Velocity) == 12 &&
+                      sizeof(Collider) == 8 && sizeof(GlyphRenderable) == 4,
+        "Serialized component layout changed: bump SNAPSHOT_VERSION");
+
+auto save_world(const std::string& path, const Registry& world,
+        const Dungeon& dungeon) -> bool {
+    SnapshotWriter writer;
+    writer.write_entities(world.entity_manager());
+    writer.write_components<Transform>(TRANSFORM_TAG, world);
+    writer.write_components<Velocity>(VELOCITY_TAG, world);
+    writer.write_components<Collider>(COLLIDER_TAG, world);
+    writer.write_components<GlyphRenderable>(GLYPH_RENDERABLE_TAG, world);
+
+    writer.write_value(DUNGEON_SIZE_TAG,
+            SnapshotPart::Data,
+            DungeonExtent{.width = dungeon.width(), .height = dungeon.height()});
+    writer.write_array(DUNGEON_TILES_TAG, SnapshotPart::Data, dungeon.tiles());
+
+    return writer.save(path);
+}
+
+auto load_world(const std::string& path, Registry& world, Dungeon& dungeon)
+        -> bool {
+    const auto reader = SnapshotReader::open(path);
+    if (!reader) {
+        return false;
+    }
+
+    // Build into fresh objects so a bad file can't leave a half-loaded world.
+    // Component chunks are checked against the entities read first.
+    Registry loaded_world;
+    bool     ok = reader->read_entities(loaded_world.entity_manager());
+    ok = ok && reader->read_components<Transform>(TRANSFORM_TAG, loaded_world);
+    ok = ok && reader->read_components<Velocity>(VELOCITY_TAG, loaded_world);
+    ok = ok && reader->read_components<Collider>(COLLIDER_TAG, loaded_world);
+    ok = ok && reader->read_components<GlyphRenderable>(
+                       GLYPH_RENDERABLE_TAG, loaded_world);
+
+    const auto extent =
+            reader->read_value<DungeonExtent>(DUNGEON_SIZE_TAG, SnapshotPart::Data);
+    const auto tiles =
+            reader->read_array<TileType>(DUNGEON_TILES_TAG, SnapshotPart::Data);
+    ok = ok && extent && tiles && tiles->size() == extent->width * extent->height;
+    if (!ok) {
+        std::println(stderr, "Snapshot '{}' is missing world data", path);
+        return false;
+    }
+
+    Dungeon loaded_dungeon(
+            {.width = extent->width, .height = extent->height});
+    loaded_dungeon.assign_tiles(*tiles);
+
+    world.restore(std::move(loaded_world));
+    dungeon = std::move(loaded_dungeon);
+    return true;
+}
@@ -0,0 +1,23 @@
+//-----------------------------------------------------------------------------
+// src/game/world/snapshot/world_snapshot.ixx
+// Save/load the ECS world and dungeon through the engine snapshot format
+//-----------------------------------------------------------------------------
+module;
+#include <string>
+
+export module Game.World.Snapshot;
+
+import Engine.Ecs.Registry;
+import Game.World.Dungeon;
+
+// Writes entity bookkeeping, every trivially-copyable gameplay component
+// storage and the dungeon tiles to `path`.
+export auto save_world(const std::string& path, const Registry& world,
+                       const Dungeon& dungeon) -> bool;
+
+// Replaces `world` and `dungeon` with the contents of `path`. On failure
+// both are left untouched. Groups declared on `world` are kept. TileMap is
+// derived from the dungeon and is not stored; rebuild it with
+// DungeonToTileMapSystem after loading.
+export auto load_world(const std::string& path, Registry& world,
+                       Dungeon& dungeon) -> bool;
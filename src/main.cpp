@@ -1,22 +1,41 @@
 //-----------------------------------------------------------------------------
 // main.cpp
 //-----------------------------------------------------------------------------
-#include "SDL3/SDL_events.h"
 #include "SDL3/SDL_init.h"
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <print>
+#include <span>
+#include <string>
+#include <string_view>
 #include <utility>
 
-import Engine.Platform.Sdl; // GraphicsContext
+import Engine.Core; // mix_seed
+import Engine.Platform.Sdl; // GraphicsContext, poll_input_events
+import Engine.Input; // InputFrame
+import Engine.Jobs.ThreadPool; // ThreadPool
+import Engine.Assets.AssetManager; // AssetManager, AssetState
 import Engine.Ecs.Registry; // Registry
+import Engine.Ecs.Telemetry; // RegistryTelemetry
 import Engine.Ecs.Entity; // Entity
 import Engine.Rendering.Systems.Core; // RenderSystem
 import Engine.Rendering.RendererInterface; // IRenderer
 import Engine.Rendering.OpenGlRenderer; // OpenGLRenderer
+import Engine.Spatial.SpatialIndex; // SpatialIndex
+import Engine.Spatial.Systems.SpatialIndex; // SpatialIndexSystem
+import Engine.Replay; // ReplayRecorder, run_replay
+import Engine.Replay.StateHasher; // StateHasher
+import Engine.Physics.Components.Transform; // Transform
+import Engine.Physics.Components.Velocity; // Velocity
+import Engine.Physics.Components.Collider; // Collider
+import Engine.Rendering.Components.GlyphRenderable; // GlyphRenderable
 import Game.World.Dungeon; // Dungeon
 import Game.World.Dungeon.Systems.DungeonToTileMap; // DungeonToTileMapSystem
 import Game.Actors.PlayerFactory; // create_player()
+import Game.Simulation; // Simulation
 
 constexpr int         SCREEN_WIDTH    = 800;
 constexpr int         SCREEN_HEIGHT   = 600;
@@ -24,19 +43,137 @@ constexpr int         TILEMAP_COLS    = 80;
 constexpr int         TILEMAP_ROWS    = 25;
 static constexpr auto FONT_ATLAS_PATH = "assets/fonts/cp437_8x16.png";
 
-auto main() -> int {
+// Main-thread time per frame spent uploading decoded textures to the GPU
+static constexpr std::chrono::microseconds ASSET_UPLOAD_BUDGET{2000};
+
+// ECS stats are sampled every second; with --stats-log a summary line is
+// also logged every STATS_LOG_EVERY samples (instance sizing, leak hunting)
+static constexpr uint64_t STATS_LOG_EVERY = 10;
+
+struct LaunchOptions {
+    std::optional<std::string> record_path; // --record <file>
+    std::optional<std::string> replay_path; // --replay <file>
+    bool                       stats_log{false}; // --stats-log
+};
+
+static auto parse_options(const std::span<char*> args)
+        -> std::optional<LaunchOptions> {
+    LaunchOptions options;
+    for (size_t arg_idx = 1; arg_idx < args.size(); ++arg_idx) {
+        const std::string_view arg = args[arg_idx];
+        if ((arg == "--record" || arg == "--replay") &&
+                arg_idx + 1 < args.size()) {
+            auto& path = arg == "--record" ? options.record_path
+                                           : options.replay_path;
+            path       = args[++arg_idx];
+        } else if (arg == "--stats-log") {
+            options.stats_log = true;
+        } else {
+            std::println(stderr,
+                    "Usage: {} [--record <file> | --replay <file>] "
+                    "[--stats-log]",
+                    args[0]);
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+// Headless playback: no window, no frame pacing; report determinism + timing
+static auto replay_session(const std::string& path,
+        const std::function<void(const InputFrame&)>& tick, Registry& world,
+        const StateHasher& hasher) -> int {
+    const auto ticks = load_replay(path);
+    if (!ticks) {
+        return 1;
+    }
+
+    const auto result =
+            run_replay(*ticks, tick, [&] { return hasher.hash(world); });
+
+    std::println("Replayed {} / {} ticks in {:.3f} ms (avg {:.3f} us, max "
+                 "{:.3f} us)",
+            result.ticks,
+            ticks->size(),
+            static_cast<double>(result.total_ns) / 1e6,
+            result.ticks == 0 ? 0.0
+                              : static_cast<double>(result.total_ns) /
+                                        static_cast<double>(result.ticks) /
+                                        1e3,
+            static_cast<double>(result.max_tick_ns) / 1e3);
+
+    // Footprint after the run, for sizing headless instances
+    RegistryTelemetry telemetry;
+    telemetry.update(world, RegistryTelemetry::Clock::now());
+    std::println("{}", telemetry.summary());
+
+    if (result.first_mismatch) {
+        std::println(stderr,
+                "Replay diverged at tick {}",
+                *result.first_mismatch);
+        return 1;
+    }
+    return 0;
+}
+
+auto main(int argc, char* argv[]) -> int {
+    const auto options = parse_options(std::span(argv, argc));
+    if (!options) {
+        return 1;
+    }
+
     //------------------------------------------------------------------------
     // 1) Generate dungeon & initialize ECS world
     //------------------------------------------------------------------------
     Dungeon dungeon({.width = TILEMAP_COLS, .height = TILEMAP_ROWS});
     dungeon.generate();
 
-    Registry               world;
+    Registry world;
+    // The renderer joins these every frame; keep them packed and aligned
+    world.group<Transform, GlyphRenderable>();
+
     DungeonToTileMapSystem map_system(dungeon);
     map_system.initialize(world);
 
     // spawn player at tile (2,2)
-    [[maybe_unused]] Entity player = create_player(world, 2, 2);
+    const Entity player = create_player(world, 2, 2);
+
+    // Tile-cell index for "what is at / near (x, y)" gameplay queries
+    SpatialIndex       spatial_index(TILEMAP_COLS, TILEMAP_ROWS);
+    SpatialIndexSystem spatial_system(spatial_index);
+    spatial_system.update(world);
+
+    // Setup is done: pack every storage in entity order before the first tick
+    world.compact();
+
+    // All gameplay state changes go through the simulation, fed by InputFrames
+    Simulation  simulation(world, dungeon, player);
+    StateHasher hasher;
+    hasher.add<Transform>();
+    hasher.add<Velocity>();
+    hasher.add<Collider>();
+    hasher.add<GlyphRenderable>();
+
+    // One fixed tick: simulation, then the systems deriving state from it;
+    // closing the tick hands its writes to change observers
+    const auto tick = [&](const InputFrame& frame) {
+        simulation.step(frame);
+        map_system.update(world);
+        spatial_system.update(world);
+        world.advance_tick();
+    };
+
+    if (options->replay_path) {
+        return replay_session(*options->replay_path, tick, world, hasher);
+    }
+
+    std::optional<ReplayRecorder> recorder;
+    if (options->record_path) {
+        recorder = ReplayRecorder::create(*options->record_path);
+        if (!recorder) {
+            return -1;
+        }
+    }
 
     //------------------------------------------------------------------------
     // 2) Create the GraphicsContext (SDL + GL)
@@ -50,10 +187,19 @@ auto main() -> int {
     SdlGlGraphicsContext graphics_context = std::move(*maybe_gc);
 
     //------------------------------------------------------------------------
-    // 3) Create the OpenGL‐based renderer (implements IRenderer)
+    // 3) Start the worker pool (asset decodes, render prep jobs) and create
+    //    the OpenGL‐based renderer (implements IRenderer); textures stream in
+    //    over the first frames
     //------------------------------------------------------------------------
-    auto renderer = OpenGlRenderer::create(
-            FONT_ATLAS_PATH, SCREEN_WIDTH, SCREEN_HEIGHT);
+    ThreadPool   worker_pool;
+    AssetManager assets(worker_pool);
+
+    // Kept to watch the decode: a font that fails to load is fatal
+    const TextureHandle font_atlas = assets.load_texture(FONT_ATLAS_PATH);
+    auto renderer = OpenGlRenderer::create(font_atlas,
+            SCREEN_WIDTH,
+            SCREEN_HEIGHT,
+            worker_pool);
     if (!renderer) {
         std::println("Failed to initialize renderer");
         return -1;
@@ -62,18 +208,60 @@ auto main() -> int {
     //------------------------------------------------------------------------
     // 4) Hook up the RenderSystem with our ECS world + renderer
     //------------------------------------------------------------------------
-    RenderSystem render_system(graphics_context, std::move(renderer));
+    RenderSystem render_system(
+            graphics_context, std::move(renderer), worker_pool);
     render_system.set_world(world);
+    render_system.set_spatial_index(spatial_index);
 
     //------------------------------------------------------------------------
     // 5) Main loop
     //------------------------------------------------------------------------
-    bool is_running = true;
-    while (is_running) {
-        SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_EVENT_QUIT) {
-                is_running = false;
+    // Per-tick seeds derive from one session seed; each is recorded with its
+    // frame, so replays never need to know how it was chosen.
+    const auto session_seed = static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+    InputFrame        frame;
+    RegistryTelemetry telemetry;
+    bool              show_stats       = false;
+    bool              recording_failed = false;
+    bool              atlas_failed     = false;
+    while (!simulation.quit_requested()) {
+        frame.events.clear();
+        frame.seed = mix_seed(session_seed + simulation.ticks());
+        poll_input_events(frame.events);
+
+        // F3 toggles the ECS stats overlay; it is not gameplay input
+        for (const InputEvent& event : frame.events) {
+            if (event.type == InputEventType::KeyDown && event.key == Key::F3 &&
+                    event.repeat == 0) {
+                show_stats = !show_stats;
+                render_system.set_overlay(show_stats
+                                ? telemetry.overlay_lines()
+                                : std::span<const std::string>{});
+            }
+        }
+
+        tick(frame);
+        if (recorder && !recorder->record(frame, hasher.hash(world))) {
+            // Already reported; the file keeps the ticks written so far
+            recorder.reset();
+            recording_failed = true;
+        }
+
+        assets.pump_uploads(ASSET_UPLOAD_BUDGET);
+        if (font_atlas.state() == AssetState::Failed) {
+            std::println(stderr, "Failed to load font atlas: {}", FONT_ATLAS_PATH);
+            atlas_failed = true;
+            break;
+        }
+
+        if (telemetry.update(world, RegistryTelemetry::Clock::now())) {
+            if (show_stats) {
+                render_system.set_overlay(telemetry.overlay_lines());
+            }
+            if (options->stats_log &&
+                    telemetry.samples() % STATS_LOG_EVERY == 0) {
+                std::println("{}", telemetry.summary());
             }
         }
 
@@ -85,5 +273,9 @@ auto main() -> int {
     // 6) Cleanup
     //------------------------------------------------------------------------
     SDL_Quit();
-    return 0;
+    // Buffered writes can still fail when the recording is closed
+    if (recorder && !recorder->close()) {
+        recording_failed = true;
+    }
+    return recording_failed || atlas_failed ? 1 : 0;
 }
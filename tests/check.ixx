@@ -0,0 +1,39 @@
+//-----------------------------------------------------------------------------
+// tests/check.ixx
+// Minimal expectation helper shared by the engine tests
+//-----------------------------------------------------------------------------
+module;
+#include <cstdio>
+#include <print>
+#include <source_location>
+#include <string_view>
+
+export module Tests.Check;
+
+namespace {
+int failure_count = 0;
+}
+
+// Report a failed expectation with its call site. Tests keep going after a
+// failure so one run lists everything that broke.
+export auto check(const bool condition, const std::string_view what,
+        const std::source_location where = std::source_location::current())
+        -> bool {
+    if (!condition) {
+        ++failure_count;
+        std::println(stderr,
+                "{}:{}: check failed: {}",
+                where.file_name(),
+                where.line(),
+                what);
+    }
+    return condition;
+}
+
+// Exit code for main(): 0 when every check passed
+export auto test_result() -> int {
+    if (failure_count != 0) {
+        std::println(stderr, "{} check(s) failed", failure_count);
+    }
+    return failure_count == 0 ? 0 : 1;
+}
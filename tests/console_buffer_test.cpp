@@ -0,0 +1,212 @@
+//-----------------------------------------------------------------------------
+// tests/console_buffer_test.cpp
+// ConsoleBuffer byte kernels against per-cell scalar references. Widths are
+// chosen so every row band has both full 16-byte blocks and a scalar tail.
+// Build with SSSE3 enabled (e.g. -march=x86-64-v2) to cover the shuffle
+// path of translate_cells as well.
+//-----------------------------------------------------------------------------
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+import Tests.Check;
+import Engine.Core;
+import Engine.Rendering.Console;
+
+static constexpr uint32_t COLS = 37;
+static constexpr uint32_t ROWS = 11;
+
+static auto random_cell(std::mt19937& rng) -> ConsoleCell {
+    const auto byte = [&] { return static_cast<uint8_t>(rng()); };
+    // Plenty of empty glyphs so both sides of the select are exercised
+    return {.glyph = rng() % 3 == 0 ? uint8_t{0} : byte(),
+            .flags = byte(),
+            .fg    = {byte(), byte(), byte()},
+            .bg    = {byte(), byte(), byte()}};
+}
+
+static auto random_buffer(std::mt19937& rng) -> ConsoleBuffer {
+    ConsoleBuffer buffer(COLS, ROWS);
+    for (size_t idx = 0; idx < buffer.cell_count(); ++idx) {
+        buffer.set_cell(idx, random_cell(rng));
+    }
+    return buffer;
+}
+
+// The documented compose rule, one cell at a time
+static auto compose_cell(const ConsoleCell& base, const ConsoleCell& over)
+        -> ConsoleCell {
+    if (over.glyph == 0) {
+        return base;
+    }
+    ConsoleCell result = base;
+    result.glyph       = over.glyph;
+    result.flags       = over.flags;
+    result.fg          = over.fg;
+    if ((over.flags & CELL_PAINTS_BACKGROUND) != 0) {
+        result.bg = over.bg;
+    }
+    return result;
+}
+
+static auto scale_channel(const uint8_t value, const uint8_t level) -> uint8_t {
+    return static_cast<uint8_t>(((value * level) + 127) / 255);
+}
+
+static void test_compose() {
+    std::mt19937 rng(31);
+    for (int round = 0; round < 20; ++round) {
+        const ConsoleBuffer base  = random_buffer(rng);
+        const ConsoleBuffer layer = random_buffer(rng);
+
+        ConsoleBuffer whole = base;
+        whole.compose(layer);
+
+        // Uneven row bands must match the single full pass
+        ConsoleBuffer banded = base;
+        banded.compose_rows(layer, 0, 3);
+        banded.compose_rows(layer, 3, 7);
+        banded.compose_rows(layer, 10, 1);
+
+        bool matches = true;
+        bool banded_matches = true;
+        for (size_t idx = 0; idx < base.cell_count(); ++idx) {
+            const ConsoleCell expected = compose_cell(base.cell(idx), layer.cell(idx));
+            matches        = matches && whole.cell(idx) == expected;
+            banded_matches = banded_matches && banded.cell(idx) == expected;
+        }
+        check(matches, "compose matches the per-cell rule");
+        check(banded_matches, "row bands compose like one pass");
+    }
+}
+
+static void test_light() {
+    // Every (value, level) pair: one row per value, one column per level
+    ConsoleBuffer        buffer(256, 256);
+    std::vector<uint8_t> light(buffer.cell_count());
+    for (uint32_t row = 0; row < 256; ++row) {
+        for (uint32_t col = 0; col < 256; ++col) {
+            const auto value = static_cast<uint8_t>(row);
+            buffer.set_cell_at(col, row,
+                    {.glyph = 1,
+                            .flags = 0,
+                            .fg    = {value, value, value},
+                            .bg    = {value, value, value}});
+            light[(static_cast<size_t>(row) * 256) + col] = static_cast<uint8_t>(col);
+        }
+    }
+    buffer.light(light);
+
+    bool exact = true;
+    for (uint32_t row = 0; row < 256; ++row) {
+        for (uint32_t col = 0; col < 256; ++col) {
+            const uint8_t     expected = scale_channel(
+                    static_cast<uint8_t>(row), static_cast<uint8_t>(col));
+            const ConsoleCell cell     = buffer.cell_at(col, row);
+            exact = exact && cell.glyph == 1 && cell.fg.r == expected &&
+                    cell.fg.g == expected && cell.fg.b == expected &&
+                    cell.bg.r == expected && cell.bg.g == expected &&
+                    cell.bg.b == expected;
+        }
+    }
+    check(exact, "light rounds v * l / 255 to nearest for every pair");
+
+    // Odd-sized band with a tail
+    std::mt19937        rng(32);
+    const ConsoleBuffer base = random_buffer(rng);
+    std::vector<uint8_t> levels(base.cell_count());
+    for (auto& level : levels) {
+        level = static_cast<uint8_t>(rng());
+    }
+    ConsoleBuffer lit = base;
+    lit.light_rows(levels, 2, 9);
+    bool banded = true;
+    for (size_t idx = 0; idx < base.cell_count(); ++idx) {
+        ConsoleCell expected = base.cell(idx);
+        if (idx >= static_cast<size_t>(2) * COLS) {
+            for (uint8_t* channel : {&expected.fg.r,
+                         &expected.fg.g,
+                         &expected.fg.b,
+                         &expected.bg.r,
+                         &expected.bg.g,
+                         &expected.bg.b}) {
+                *channel = scale_channel(*channel, levels[idx]);
+            }
+        }
+        banded = banded && lit.cell(idx) == expected;
+    }
+    check(banded, "light_rows only touches its band");
+}
+
+// Compact enum (a few keys, rest zero), sparse keys across many 16-entry
+// blocks, and a fully random table
+static auto sample_luts(std::mt19937& rng) -> std::vector<CellLut> {
+    const auto compact = make_cell_lut([](const uint8_t key) {
+        return key < 5 ? ConsoleCell{.glyph = static_cast<uint8_t>('#' + key),
+                                 .flags = CELL_PAINTS_BACKGROUND,
+                                 .fg    = {key, 2, 3},
+                                 .bg    = {4, key, 6}}
+                       : ConsoleCell{};
+    });
+    const auto sparse = make_cell_lut([](const uint8_t key) {
+        return key % 23 == 0 ? ConsoleCell{.glyph = key, .flags = 1}
+                             : ConsoleCell{.glyph = '.'};
+    });
+    CellLut random{};
+    for (auto& plane : random) {
+        for (auto& entry : plane) {
+            entry = static_cast<uint8_t>(rng());
+        }
+    }
+    return {compact, sparse, random};
+}
+
+static void test_translate() {
+    std::mt19937 rng(32);
+    for (const CellLut& lut : sample_luts(rng)) {
+        for (const size_t count : {size_t{0}, size_t{7}, size_t{16}, size_t{83}, size_t{300}}) {
+            for (const size_t first : {size_t{0}, size_t{5}}) {
+                const ConsoleBuffer  base = random_buffer(rng);
+                std::vector<uint8_t> keys(count);
+                for (auto& key : keys) {
+                    // Mostly in-range keys, like a real enum, plus strays
+                    key = static_cast<uint8_t>(rng() % 4 == 0 ? rng() : rng() % 5);
+                }
+
+                ConsoleBuffer translated = base;
+                translated.translate_cells(keys, lut, first);
+
+                bool matches = true;
+                for (size_t idx = 0; idx < base.cell_count(); ++idx) {
+                    const bool in_range = idx >= first && idx < first + count;
+                    ConsoleCell expected = base.cell(idx);
+                    if (in_range) {
+                        const uint8_t key   = keys[idx - first];
+                        const auto    entry = [&](const ConsolePlane plane) {
+                            return lut[plane_index(plane)][key];
+                        };
+                        expected = {.glyph = entry(ConsolePlane::Glyph),
+                                .flags     = entry(ConsolePlane::Flags),
+                                .fg        = {entry(ConsolePlane::FgR),
+                                               entry(ConsolePlane::FgG),
+                                               entry(ConsolePlane::FgB)},
+                                .bg        = {entry(ConsolePlane::BgR),
+                                               entry(ConsolePlane::BgG),
+                                               entry(ConsolePlane::BgB)}};
+                    }
+                    matches = matches && translated.cell(idx) == expected;
+                }
+                check(matches, "translate_cells matches the scalar table lookup");
+            }
+        }
+    }
+}
+
+auto main() -> int {
+    test_compose();
+    test_light();
+    test_translate();
+    return test_result();
+}
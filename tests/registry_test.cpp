@@ -0,0 +1,297 @@
+//-----------------------------------------------------------------------------
+// tests/registry_test.cpp
+// Owned-group packing under random churn, sorting, compaction and adopt();
+// telemetry churn rates and change ticks across a restore()
+//-----------------------------------------------------------------------------
+#include "glm/vec2.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+import Tests.Check;
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+import Engine.Ecs.Telemetry;
+import Engine.Physics.Components.Collider;
+import Engine.Physics.Components.Transform;
+import Engine.Physics.Components.Velocity;
+
+// Each component carries its entity's id, so misaligned slots show up as
+// mismatched pairs
+static auto id_of(const Entity entity) -> float {
+    return static_cast<float>(entity.index) +
+           (1000.0F * static_cast<float>(entity.generation));
+}
+
+static auto same_entity(const Entity lhs, const Entity rhs) -> bool {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+// Storages are read-only outside the Registry
+template <typename Storage>
+concept WritableStorage = requires(Storage& storage, const Entity entity) {
+    storage.remove(entity, 0U);
+} || requires(Storage& storage, const Entity entity) {
+    storage.touch(entity, 0U);
+} || requires(Storage& storage) {
+    storage.swap_dense(0, 1);
+};
+static_assert(!WritableStorage<ComponentStorage<Transform>>);
+static_assert(!WritableStorage<IComponentStorage>);
+
+template <typename C>
+static auto sparse_matches_dense(const ComponentStorage<C>* storage) -> bool {
+    if (storage == nullptr) {
+        return true;
+    }
+    const auto entities = storage->dense_entities();
+    for (size_t idx = 0; idx < entities.size(); ++idx) {
+        if (storage->dense_index(entities[idx]) != static_cast<int32_t>(idx)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The Transform/Velocity group: every entity with both sits in the first
+// `members` slots of each storage, at the same slot, and nothing else does
+static void check_group(Registry& world, const std::vector<Entity>& live) {
+    const auto* transforms = world.find_storage<Transform>();
+    const auto* velocities = world.find_storage<Velocity>();
+    check(sparse_matches_dense(transforms) && sparse_matches_dense(velocities),
+            "sparse and dense agree");
+
+    size_t members = 0;
+    for (const Entity entity : live) {
+        members += world.has_component<Transform>(entity) &&
+                   world.has_component<Velocity>(entity);
+    }
+    if (members == 0) {
+        return;
+    }
+
+    const auto transform_entities = transforms->dense_entities();
+    const auto velocity_entities  = velocities->dense_entities();
+    bool       lockstep           = true;
+    for (size_t idx = 0; idx < members; ++idx) {
+        lockstep = lockstep &&
+                   same_entity(transform_entities[idx], velocity_entities[idx]) &&
+                   world.has_component<Velocity>(transform_entities[idx]);
+    }
+    check(lockstep, "group members are packed in lockstep");
+
+    size_t visited = 0;
+    bool   paired  = true;
+    world.for_each<Transform, Velocity>(
+            [&](const Transform& transform, const Velocity& velocity) {
+                paired = paired && transform.position.x == velocity.velocity.x;
+                ++visited;
+            });
+    size_t reversed = 0;
+    world.for_each<Velocity, Transform>(
+            [&](const Velocity& /*velocity*/, const Transform& /*transform*/) {
+                ++reversed;
+            });
+    check(paired, "for_each pairs each entity's own components");
+    check(visited == members && reversed == members,
+            "for_each visits exactly the group members");
+}
+
+static void test_churn() {
+    std::mt19937        rng(7);
+    Registry            world;
+    std::vector<Entity> live;
+
+    const auto add_transform = [&](const Entity entity) {
+        world.add_component<Transform>(
+                entity, Transform{.position = glm::vec2(id_of(entity), 0.0F)});
+    };
+    const auto add_velocity = [&](const Entity entity) {
+        world.add_component<Velocity>(entity,
+                Velocity{.velocity = glm::vec2(id_of(entity), 0.0F), .speed = 1.0F});
+    };
+
+    // Some entities exist before the group is declared
+    for (int idx = 0; idx < 300; ++idx) {
+        const Entity entity = world.create_entity();
+        live.push_back(entity);
+        if (rng() % 2 == 0) {
+            add_transform(entity);
+        }
+        if (rng() % 2 == 0) {
+            add_velocity(entity);
+        }
+    }
+    world.group<Transform, Velocity>();
+    check_group(world, live);
+
+    const auto by_x_descending = [](const Transform& lhs, const Transform& rhs) {
+        return lhs.position.x > rhs.position.x;
+    };
+    for (int step = 0; step < 20000; ++step) {
+        const Entity entity = live.empty() ? Entity{} : live[rng() % live.size()];
+        switch (live.empty() ? 0 : rng() % 6) {
+        case 0: {
+            const Entity created = world.create_entity();
+            live.push_back(created);
+            if (rng() % 2 == 0) {
+                world.add_component<Collider>(created);
+            }
+            break;
+        }
+        case 1:
+            if (!world.has_component<Transform>(entity)) {
+                add_transform(entity);
+            }
+            break;
+        case 2:
+            if (!world.has_component<Velocity>(entity)) {
+                add_velocity(entity);
+            }
+            break;
+        case 3:
+            world.remove_component<Transform>(entity);
+            break;
+        case 4:
+            world.remove_component<Velocity>(entity);
+            break;
+        default:
+            world.destroy_entity(entity);
+            std::erase_if(live, [&](const Entity other) {
+                return same_entity(other, entity);
+            });
+            break;
+        }
+        if (step % 97 == 0) {
+            world.sort<Transform>(by_x_descending);
+        }
+        if (step % 501 == 0) {
+            world.compact();
+        }
+        if (step % 13 == 0) {
+            check_group(world, live);
+        }
+    }
+
+    // Sorting keeps members and non-members apart, each range ordered
+    world.sort<Transform>([](const Transform& lhs, const Transform& rhs) {
+        return lhs.position.x < rhs.position.x;
+    });
+    check_group(world, live);
+    size_t members = 0;
+    world.for_each<Transform, Velocity>(
+            [&](const Transform& /*transform*/, const Velocity& /*velocity*/) {
+                ++members;
+            });
+    const auto transforms = world.find_storage<Transform>()->dense_components();
+    const auto ordered    = [](const Transform& lhs, const Transform& rhs) {
+        return lhs.position.x < rhs.position.x;
+    };
+    check(std::is_sorted(transforms.begin(), transforms.begin() + members, ordered) &&
+                    std::is_sorted(transforms.begin() + members, transforms.end(), ordered),
+            "sort orders the group and the rest separately");
+}
+
+static void test_adopt_repacks_group() {
+    // Capture Velocity arrays from a registry without a group...
+    Registry            source;
+    std::vector<Entity> live;
+    for (int idx = 0; idx < 200; ++idx) {
+        const Entity entity = source.create_entity();
+        live.push_back(entity);
+        if (idx % 3 != 0) {
+            source.add_component<Velocity>(entity,
+                    Velocity{.velocity = glm::vec2(id_of(entity), 0.0F), .speed = 1.0F});
+        }
+    }
+    const auto* captured = source.find_storage<Velocity>();
+
+    // ...and adopt them where a group over Velocity is already packed
+    Registry target;
+    target.group<Transform, Velocity>();
+    for (int idx = 0; idx < 200; ++idx) {
+        const Entity entity = target.create_entity();
+        if (idx % 2 == 0) {
+            target.add_component<Transform>(
+                    entity, Transform{.position = glm::vec2(id_of(entity), 0.0F)});
+        }
+        target.add_component<Velocity>(entity);
+    }
+    target.adopt<Velocity>(captured->dense_components(),
+            captured->dense_entities(),
+            captured->sparse_indices());
+    check_group(target, live);
+}
+
+static void test_telemetry_across_restore() {
+    Registry world;
+    for (int idx = 0; idx < 500; ++idx) {
+        world.create_entity();
+    }
+
+    RegistryTelemetry telemetry;
+    auto              now = RegistryTelemetry::Clock::now();
+    telemetry.update(world, now);
+
+    // A freshly loaded world restarts the lifetime counters near zero
+    Registry loaded;
+    loaded.create_entity();
+    world.restore(std::move(loaded));
+    now += std::chrono::seconds(1);
+    telemetry.update(world, now);
+    check(telemetry.created_per_second() == 0.0 &&
+                    telemetry.destroyed_per_second() == 0.0,
+            "counters going backwards report no churn");
+
+    // ...and the next sample measures from the new baseline
+    for (int idx = 0; idx < 20; ++idx) {
+        world.create_entity();
+    }
+    now += std::chrono::seconds(2);
+    telemetry.update(world, now);
+    check(telemetry.created_per_second() == 10.0,
+            "rates resume from the re-seeded baseline");
+}
+
+static void test_restore_moves_tick_forward() {
+    Registry world;
+    for (int idx = 0; idx < 10; ++idx) {
+        world.advance_tick();
+    }
+    const Entity dropped = world.create_entity();
+    world.add_component<Velocity>(dropped);
+    const uint32_t before = world.current_tick();
+
+    // A loaded world is usually far behind the running one
+    Registry loaded;
+    for (int idx = 0; idx < 3; ++idx) {
+        loaded.add_component<Transform>(loaded.create_entity());
+    }
+    loaded.add_component<Velocity>(loaded.create_entity());
+    world.restore(std::move(loaded));
+
+    const uint32_t now = world.current_tick();
+    check(now > before, "restore never moves the tick backwards");
+    const auto stamped_now = [&](const auto* storage) {
+        return std::ranges::all_of(storage->versions(),
+                [&](const uint32_t version) { return version == now; });
+    };
+    check(stamped_now(world.find_storage<Transform>()) &&
+                    stamped_now(world.find_storage<Velocity>()),
+            "restored components count as changed in the new tick");
+    check(!world.find_storage<Velocity>()->removals_since(before).has_value(),
+            "observers behind the restore are told to resync");
+}
+
+auto main() -> int {
+    test_churn();
+    test_adopt_repacks_group();
+    test_telemetry_across_restore();
+    test_restore_moves_tick_forward();
+    return test_result();
+}
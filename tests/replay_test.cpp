@@ -0,0 +1,165 @@
+//-----------------------------------------------------------------------------
+// tests/replay_test.cpp
+// Record a scripted session, replay it headless into a fresh world and check
+// every tick's state hash; also check divergence and write-failure reporting
+//-----------------------------------------------------------------------------
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+import Tests.Check;
+import Engine.Core;
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+import Engine.Input;
+import Engine.Physics.Components.Collider;
+import Engine.Physics.Components.Transform;
+import Engine.Physics.Components.Velocity;
+import Engine.Rendering.Components.GlyphRenderable;
+import Engine.Replay;
+import Engine.Replay.StateHasher;
+import Engine.Spatial.SpatialIndex;
+import Engine.Spatial.Systems.SpatialIndex;
+import Game.Actors.PlayerFactory;
+import Game.Simulation;
+import Game.World.Dungeon;
+import Game.World.Dungeon.Systems.DungeonToTileMap;
+
+static constexpr size_t   MAP_COLS   = 80;
+static constexpr size_t   MAP_ROWS   = 25;
+static constexpr uint64_t TICK_COUNT = 600;
+
+static auto populate(Dungeon& dungeon, DungeonToTileMapSystem& map_system,
+        Registry& world) -> Entity {
+    dungeon.generate();
+    world.group<Transform, GlyphRenderable>();
+    map_system.initialize(world);
+    return create_player(world, 2, 2);
+}
+
+// The same world main() builds, minus the window
+struct Session {
+    Session()
+        : dungeon({.width = MAP_COLS, .height = MAP_ROWS}),
+          map_system(dungeon),
+          spatial_index(MAP_COLS, MAP_ROWS),
+          spatial_system(spatial_index),
+          player(populate(dungeon, map_system, world)),
+          simulation(world, dungeon, player) {
+        spatial_system.update(world);
+        hasher.add<Transform>();
+        hasher.add<Velocity>();
+        hasher.add<Collider>();
+        hasher.add<GlyphRenderable>();
+    }
+
+    void step(const InputFrame& frame) {
+        simulation.step(frame);
+        map_system.update(world);
+        spatial_system.update(world);
+        world.advance_tick();
+    }
+
+    Dungeon                dungeon;
+    Registry               world;
+    DungeonToTileMapSystem map_system;
+    SpatialIndex           spatial_index;
+    SpatialIndexSystem     spatial_system;
+    Entity                 player;
+    Simulation             simulation;
+    StateHasher            hasher;
+};
+
+// Deterministic wandering: a key press most ticks, seeds from a fixed root
+static auto scripted_frame(const uint64_t tick) -> InputFrame {
+    constexpr std::array KEYS = {Key::Right, Key::Down, Key::Left, Key::Up};
+    InputFrame frame;
+    frame.seed = mix_seed(tick);
+    if (tick % 5 != 0) {
+        frame.events.push_back({.key = KEYS[(tick / 17) % KEYS.size()],
+                .modifiers          = 0,
+                .type               = InputEventType::KeyDown,
+                .repeat             = 0});
+    }
+    return frame;
+}
+
+static auto replay_into(Session& session, const std::vector<ReplayTick>& ticks)
+        -> ReplayResult {
+    return run_replay(
+            ticks,
+            [&](const InputFrame& frame) { session.step(frame); },
+            [&] { return session.hasher.hash(session.world); });
+}
+
+static void test_record_and_replay(const std::string& path) {
+    {
+        Session recorded;
+        auto    recorder = ReplayRecorder::create(path);
+        check(recorder.has_value(), "recorder opens");
+        if (!recorder) {
+            return;
+        }
+        for (uint64_t tick = 0; tick < TICK_COUNT; ++tick) {
+            const InputFrame frame = scripted_frame(tick);
+            recorded.step(frame);
+            check(recorder->record(
+                          frame, recorded.hasher.hash(recorded.world)),
+                    "tick recorded");
+        }
+        check(recorder->close(), "recording closes cleanly");
+    }
+
+    const auto ticks = load_replay(path);
+    check(ticks && ticks->size() == TICK_COUNT, "every tick loads back");
+    if (!ticks) {
+        return;
+    }
+
+    Session    replayed;
+    const auto result = replay_into(replayed, *ticks);
+    check(result.ticks == TICK_COUNT && !result.first_mismatch,
+            "fresh world replays with matching hashes on every tick");
+
+    // Any difference in starting state is caught on the first tick
+    Session perturbed;
+    perturbed.world.patch<Transform>(perturbed.player).position.x += 8.0F;
+    check(replay_into(perturbed, *ticks).first_mismatch == 0,
+            "diverging state is reported at the first tick");
+
+    // A recording cut short mid-tick keeps its complete ticks
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    const auto truncated = load_replay(path);
+    check(truncated && truncated->size() == TICK_COUNT - 1,
+            "truncated recording keeps complete ticks");
+}
+
+static void test_write_failure() {
+    // Writes to /dev/full fail with ENOSPC once the buffer is flushed
+    if (!std::filesystem::exists("/dev/full")) {
+        return;
+    }
+    auto recorder = ReplayRecorder::create("/dev/full");
+    if (!recorder) {
+        return; // header flushed early and already failed: also correct
+    }
+    bool recorded = true;
+    for (uint64_t tick = 0; tick < TICK_COUNT && recorded; ++tick) {
+        recorded = recorder->record(scripted_frame(tick), tick);
+    }
+    const bool closed = recorder->close();
+    check(!recorded || !closed, "a full disk is reported");
+}
+
+auto main() -> int {
+    const auto path =
+            (std::filesystem::temp_directory_path() / "evergenesis_replay_test.rep")
+                    .string();
+    test_record_and_replay(path);
+    test_write_failure();
+    std::filesystem::remove(path);
+    return test_result();
+}
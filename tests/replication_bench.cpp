@@ -0,0 +1,136 @@
+//-----------------------------------------------------------------------------
+// tests/replication_bench.cpp
+// Bandwidth per tick and apply latency of the delta replication stream over
+// the replication_test workload. Not registered with CTest; run it by hand.
+//-----------------------------------------------------------------------------
+#include "glm/vec2.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <vector>
+
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+import Engine.Net.LoopbackChannel;
+import Engine.Net.Replication;
+import Engine.Physics.Components.Collider;
+import Engine.Physics.Components.Transform;
+import Engine.Physics.Components.Velocity;
+import Engine.Rendering.Components.GlyphRenderable;
+import Game.World.Dungeon;
+import Game.World.Dungeon.Systems.DungeonToTileMap;
+
+static constexpr int      ENTITY_COUNT = 2000;
+static constexpr int      TICK_COUNT   = 300;
+static constexpr uint32_t MAP_COLS     = 80;
+static constexpr uint32_t MAP_ROWS     = 25;
+
+auto main() -> int {
+    ReplicationSchema schema;
+    schema.add<Transform>();
+    schema.add<Velocity>();
+    schema.add<Collider>();
+    schema.add<GlyphRenderable>();
+
+    std::mt19937 rng(42);
+    const auto   roll = [&](const size_t sides) {
+        return static_cast<uint32_t>(rng() % sides);
+    };
+
+    Dungeon dungeon({.width = MAP_COLS, .height = MAP_ROWS});
+    dungeon.generate();
+
+    Registry server;
+    server.group<Transform, Velocity>();
+    DungeonToTileMapSystem map_system(dungeon);
+    map_system.initialize(server);
+
+    std::vector<Entity> actors;
+    const auto          spawn = [&] {
+        const Entity entity = server.create_entity();
+        const auto   x_pos  = static_cast<float>(roll(640));
+        server.add_component<Transform>(
+                entity, Transform{.position = glm::vec2(x_pos, 0.0F)});
+        if (roll(2) == 0) {
+            server.add_component<Velocity>(entity,
+                    Velocity{.velocity = glm::vec2(1.0F, 0.5F), .speed = 1.0F});
+        }
+        if (roll(3) == 0) {
+            server.add_component<GlyphRenderable>(
+                    entity, GlyphRenderable{.glyph = 'g'});
+        }
+        actors.push_back(entity);
+    };
+    for (int idx = 0; idx < ENTITY_COUNT; ++idx) {
+        spawn();
+    }
+
+    Registry        client;
+    DeltaEncoder    encoder(schema);
+    DeltaApplier    applier(schema);
+    LoopbackChannel channel;
+
+    size_t first_packet = 0;
+    size_t max_delta    = 0;
+    for (int tick = 0; tick < TICK_COUNT; ++tick) {
+        if (tick > 0) {
+            server.for_each<Transform, Velocity>(
+                    [](Transform& transform, const Velocity& velocity) {
+                        transform.position.x += velocity.velocity.x;
+                        transform.position.y += velocity.velocity.y;
+                    });
+            for (int edit = 0; edit < 10; ++edit) {
+                const Entity entity = actors[roll(actors.size())];
+                server.get_component<Transform>(entity).position.y += 16.0F;
+            }
+            for (int edit = 0; edit < 5; ++edit) {
+                const size_t victim = roll(actors.size());
+                server.destroy_entity(actors[victim]);
+                actors[victim] = actors.back();
+                actors.pop_back();
+                spawn();
+            }
+            const Entity entity = actors[roll(actors.size())];
+            if (server.has_component<Collider>(entity)) {
+                server.remove_component<Collider>(entity);
+            } else {
+                server.add_component<Collider>(
+                        entity, Collider{.width = 8.0F, .height = 16.0F});
+            }
+            if (tick % 10 == 0) {
+                dungeon.set_tile(roll(MAP_COLS), roll(MAP_ROWS), TileType::Door);
+                map_system.update(server);
+            }
+        }
+        server.advance_tick();
+
+        channel.send(encoder.encode(server));
+        while (auto packet = channel.receive()) {
+            applier.apply(*packet, client);
+        }
+        const size_t packet_bytes = encoder.stats().last_packet_bytes;
+        if (tick == 0) {
+            first_packet = packet_bytes;
+        } else {
+            max_delta = std::max(max_delta, packet_bytes);
+        }
+    }
+
+    // Steady-state bandwidth excludes the initial full-state packet
+    const auto& sent  = encoder.stats();
+    const auto& apply = applier.stats();
+    std::println("replication: {} entities, {} ticks", ENTITY_COUNT, TICK_COUNT);
+    std::println("  full state   {} B", first_packet);
+    std::println("  delta        {:.1f} B/tick avg, {} B max",
+            static_cast<double>(sent.total_bytes - first_packet) /
+                    (TICK_COUNT - 1),
+            max_delta);
+    std::println("  apply        {:.1f} us avg, {:.1f} us max",
+            static_cast<double>(apply.total_apply_ns) / 1e3 /
+                    static_cast<double>(apply.packets),
+            static_cast<double>(apply.max_apply_ns) / 1e3);
+    return 0;
+}
@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+// tests/snapshot_test.cpp
+// World snapshot round trip, group survival and rejection of bad files
+//-----------------------------------------------------------------------------
+#include "glm/vec2.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+import Tests.Check;
+import Engine.Core;
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+import Engine.Physics.Components.Collider;
+import Engine.Physics.Components.Transform;
+import Engine.Physics.Components.Velocity;
+import Engine.Rendering.Components.GlyphRenderable;
+import Engine.Serialization.Snapshot;
+import Game.World.Dungeon;
+import Game.World.Snapshot;
+
+static constexpr uint32_t TEST_TAG = make_chunk_tag("TEST");
+
+static auto temp_path(const char* name) -> std::string {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Mixed world: churned entities, partial component sets, one owned group
+static auto build_world(Registry& world) -> std::vector<Entity> {
+    std::mt19937        rng(1234);
+    std::vector<Entity> live;
+    for (int step = 0; step < 5000; ++step) {
+        if (!live.empty() && rng() % 4 == 0) {
+            const size_t victim = rng() % live.size();
+            world.destroy_entity(live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
+            continue;
+        }
+        const Entity entity = world.create_entity();
+        const auto   value  = static_cast<float>(step);
+        world.add_component<Transform>(
+                entity, Transform{.position = glm::vec2(value, -value)});
+        if (rng() % 2 == 0) {
+            world.add_component<GlyphRenderable>(entity,
+                    GlyphRenderable{.glyph = static_cast<char>('a' + (step % 26)),
+                            .color      = Rgb8{.r = 1, .g = 2, .b = 3}});
+        }
+        if (rng() % 3 == 0) {
+            world.add_component<Collider>(
+                    entity, Collider{.width = value, .height = 1.0F});
+        }
+        live.push_back(entity);
+    }
+    return live;
+}
+
+static void test_round_trip() {
+    Registry world;
+    world.group<Transform, GlyphRenderable>();
+    const auto live = build_world(world);
+
+    Dungeon dungeon({.width = 16, .height = 8});
+    dungeon.generate();
+
+    const auto path = temp_path("evergenesis_snapshot_test.snap");
+    check(save_world(path, world, dungeon), "save succeeds");
+    check(world.find_storage<Velocity>() == nullptr,
+            "saving does not create storages for missing types");
+
+    // The target already has content and its own group declaration
+    Registry loaded;
+    loaded.group<Transform, GlyphRenderable>();
+    loaded.add_component<Velocity>(loaded.create_entity());
+    Dungeon loaded_dungeon({.width = 1, .height = 1});
+    check(load_world(path, loaded, loaded_dungeon), "load succeeds");
+
+    const auto& before = world.entity_manager();
+    const auto& after  = loaded.entity_manager();
+    check(std::ranges::equal(before.generations(), after.generations()) &&
+                    std::ranges::equal(
+                            before.free_indices(), after.free_indices()),
+            "entity bookkeeping round-trips");
+
+    bool same = true;
+    for (const Entity entity : live) {
+        same = same && loaded.has_component<Transform>(entity) &&
+               loaded.get_component<Transform>(entity).position.x ==
+                       world.get_component<Transform>(entity).position.x;
+        same = same && world.has_component<GlyphRenderable>(entity) ==
+                               loaded.has_component<GlyphRenderable>(entity);
+        same = same && world.has_component<Collider>(entity) ==
+                               loaded.has_component<Collider>(entity);
+        if (same && world.has_component<GlyphRenderable>(entity)) {
+            same = loaded.get_component<GlyphRenderable>(entity).glyph ==
+                   world.get_component<GlyphRenderable>(entity).glyph;
+        }
+    }
+    check(same, "every component round-trips");
+    check(loaded.find_storage<Velocity>() == nullptr ||
+                    loaded.find_storage<Velocity>()->size() == 0,
+            "types absent from the snapshot load empty");
+    check(std::ranges::equal(dungeon.tiles(), loaded_dungeon.tiles()),
+            "dungeon tiles round-trip");
+
+    // The group declared on the target is re-packed over the loaded data
+    const auto* transforms = loaded.find_storage<Transform>();
+    const auto* glyphs     = loaded.find_storage<GlyphRenderable>();
+    size_t      joined     = 0;
+    bool        aligned    = true;
+    loaded.for_each<Transform, GlyphRenderable>(
+            [&](const Transform& transform, const GlyphRenderable& /*glyph*/) {
+                aligned = aligned &&
+                          &transform == &transforms->dense_components()[joined];
+                ++joined;
+            });
+    check(joined == glyphs->size(), "group joins every glyph entity");
+    check(aligned, "group members sit at the front, in lockstep");
+
+    std::filesystem::remove(path);
+}
+
+static void test_rejects_bad_files() {
+    const auto path = temp_path("evergenesis_snapshot_bad.snap");
+
+    // Two live entities, but the sparse map points entity 1 past the arrays
+    EntityManager entities;
+    entities.create_entity();
+    entities.create_entity();
+    const std::array<Collider, 2> components{};
+    const std::array<Entity, 2>   dense{Entity{.index = 0, .generation = 0},
+              Entity{.index = 1, .generation = 0}};
+    const std::array<int32_t, 2>  sparse{0, 7};
+
+    SnapshotWriter writer;
+    writer.write_entities(entities);
+    writer.write_array<Collider>(TEST_TAG, SnapshotPart::Data, components);
+    writer.write_array<Entity>(TEST_TAG, SnapshotPart::Entities, dense);
+    writer.write_array<int32_t>(TEST_TAG, SnapshotPart::Sparse, sparse);
+    check(writer.save(path), "save corrupt fixture");
+
+    auto reader = SnapshotReader::open(path);
+    check(reader.has_value(), "structurally valid file opens");
+    if (reader) {
+        Registry registry;
+        check(reader->read_entities(registry.entity_manager()),
+                "entities read");
+        check(!reader->read_components<Collider>(TEST_TAG, registry),
+                "out-of-range sparse slot is rejected");
+        check(registry.find_storage<Collider>() == nullptr,
+                "rejected storage is left untouched");
+    }
+
+    // Free list naming an index that was never handed out
+    const std::array<uint32_t, 1> generations{0};
+    const std::array<uint32_t, 1> free_indices{3};
+    SnapshotWriter                free_writer;
+    free_writer.write_array<uint32_t>(
+            ENTITY_CHUNK_TAG, SnapshotPart::Generations, generations);
+    free_writer.write_array<uint32_t>(
+            ENTITY_CHUNK_TAG, SnapshotPart::FreeIndices, free_indices);
+    check(free_writer.save(path), "save free-list fixture");
+    if (auto free_reader = SnapshotReader::open(path)) {
+        EntityManager restored;
+        check(!free_reader->read_entities(restored),
+                "out-of-range free index is rejected");
+    }
+
+    // Files from another format version are refused outright
+    if (std::FILE* file = std::fopen(path.c_str(), "r+b")) {
+        const uint32_t old_version = SNAPSHOT_VERSION - 1;
+        std::fseek(file, offsetof(SnapshotHeader, version), SEEK_SET);
+        std::fwrite(&old_version, sizeof(old_version), 1, file);
+        std::fclose(file);
+    }
+    check(!SnapshotReader::open(path).has_value(),
+            "older format version is rejected");
+
+    std::filesystem::remove(path);
+}
+
+auto main() -> int {
+    test_round_trip();
+    test_rejects_bad_files();
+    return test_result();
+}
@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+// tests/spatial_index_test.cpp
+// SpatialIndex queries and SpatialIndexSystem tile mapping
+//-----------------------------------------------------------------------------
+#include "glm/vec2.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+import Tests.Check;
+import Engine.Config.TileConfig;
+import Engine.Ecs.Entity;
+import Engine.Ecs.Registry;
+import Engine.Physics.Components.Transform;
+import Engine.Spatial.SpatialIndex;
+import Engine.Spatial.Systems.SpatialIndex;
+
+static auto at_pixel(const float x_pos, const float y_pos) -> Transform {
+    return Transform{.position = glm::vec2(x_pos, y_pos)};
+}
+
+static void test_queries() {
+    SpatialIndex index(8, 8);
+    const Entity first{.index = 0, .generation = 0};
+    const Entity second{.index = 1, .generation = 0};
+    const Entity third{.index = 2, .generation = 0};
+
+    index.insert(first, {.x = 1, .y = 1});
+    index.insert(second, {.x = 1, .y = 1});
+    index.insert(third, {.x = 6, .y = 6});
+    check(index.at({.x = 1, .y = 1}).size() == 2, "two entities on (1,1)");
+    check(index.at({.x = -1, .y = 0}).empty(), "out of bounds tile is empty");
+
+    std::array<Entity, 4> scratch{};
+    check(index.query_rect({.min = {.x = 0, .y = 0}, .max = {.x = 3, .y = 3}},
+                  scratch)
+                            .size() == 2,
+            "rect finds the pair near the origin");
+    check(index.query_radius({.x = 6, .y = 5}, 1, scratch).size() == 1,
+            "radius 1 reaches the neighbouring tile");
+    check(index.query_radius({.x = 5, .y = 5}, 1, scratch).empty(),
+            "radius test is Euclidean, diagonals excluded");
+
+    // Results never exceed the caller's buffer
+    std::array<Entity, 1> small{};
+    check(index.query_rect({.min = {.x = 0, .y = 0}, .max = {.x = 7, .y = 7}},
+                  small)
+                            .size() == 1,
+            "rect query truncates to the scratch size");
+
+    index.move(first, {.x = 6, .y = 6});
+    check(index.at({.x = 1, .y = 1}).size() == 1, "move leaves the old bucket");
+    check(index.at({.x = 6, .y = 6}).size() == 2, "move joins the new bucket");
+
+    index.remove(third);
+    check(!index.contains(third), "removed entity is gone");
+    check(index.contains(first) && index.contains(second),
+            "swap-and-pop keeps the others reachable");
+
+    // A stale handle to a recycled index neither matches nor evicts
+    const Entity stale{.index = first.index, .generation = 1};
+    check(!index.contains(stale), "stale generation is not contained");
+    index.remove(stale);
+    check(index.contains(first), "removing a stale handle keeps the occupant");
+
+    index.move(second, {.x = 8, .y = 0});
+    check(!index.contains(second), "moving off the map drops the entity");
+}
+
+// for_each_occupied must list exactly the non-empty buckets, once each
+static auto occupied_matches(const SpatialIndex& index) -> bool {
+    std::vector<int> visits(static_cast<size_t>(index.cols()) * index.rows(), 0);
+    bool             consistent = true;
+    index.for_each_occupied(
+            [&](const TileCoord tile, const std::span<const Entity> bucket) {
+                consistent = consistent && !bucket.empty() &&
+                             bucket.data() == index.at(tile).data();
+                ++visits[(static_cast<size_t>(tile.y) * index.cols()) +
+                         static_cast<size_t>(tile.x)];
+            });
+    for (uint32_t row = 0; row < index.rows(); ++row) {
+        for (uint32_t col = 0; col < index.cols(); ++col) {
+            const TileCoord tile{.x = static_cast<int32_t>(col),
+                    .y              = static_cast<int32_t>(row)};
+            const int expected = index.at(tile).empty() ? 0 : 1;
+            consistent = consistent &&
+                         visits[(static_cast<size_t>(row) * index.cols()) + col] ==
+                                 expected;
+        }
+    }
+    return consistent;
+}
+
+static void test_occupied_list() {
+    SpatialIndex        index(7, 5);
+    std::mt19937        rng(26);
+    std::vector<Entity> entities;
+    for (uint32_t idx = 0; idx < 40; ++idx) {
+        entities.push_back({.index = idx, .generation = 0});
+    }
+    bool consistent = true;
+    for (int step = 0; step < 5000; ++step) {
+        const Entity entity = entities[rng() % entities.size()];
+        // Includes off-map tiles, which drop the entity
+        const TileCoord tile{.x = static_cast<int32_t>(rng() % 9) - 1,
+                .y              = static_cast<int32_t>(rng() % 7) - 1};
+        switch (rng() % 3) {
+        case 0:
+            index.move(entity, tile);
+            break;
+        case 1:
+            index.remove(entity);
+            break;
+        default:
+            if (step % 500 == 0) {
+                index.clear();
+            } else {
+                index.insert(entity, tile);
+            }
+            break;
+        }
+        consistent = consistent && occupied_matches(index);
+    }
+    check(consistent, "occupied list tracks exactly the non-empty tiles");
+}
+
+static void test_system_tiles() {
+    Registry     world;
+    SpatialIndex index(4, 4);
+
+    const Entity inside   = world.create_entity();
+    const Entity negative = world.create_entity();
+    const Entity leaving  = world.create_entity();
+    world.add_component<Transform>(
+            inside, at_pixel(TILE_WIDTH * 2.5F, TILE_HEIGHT * 3.0F));
+    // Just left of the origin: tile -1, which is off the map
+    world.add_component<Transform>(
+            negative, at_pixel(-0.5F * TILE_WIDTH, TILE_HEIGHT * 0.5F));
+    world.add_component<Transform>(leaving, at_pixel(0.0F, 0.0F));
+
+    SpatialIndexSystem system(index);
+    system.update(world);
+
+    const auto tile = index.at({.x = 2, .y = 3});
+    check(tile.size() == 1 && tile.front().index == inside.index,
+            "pixel position maps to its tile");
+    check(!index.contains(negative),
+            "negative fractional positions floor off the map");
+    check(index.contains(leaving), "origin is tile (0,0)");
+
+    world.destroy_entity(leaving);
+    world.get_component<Transform>(inside).position.x = 0.0F;
+    system.update(world);
+    check(!index.contains(leaving), "destroyed entity leaves the index");
+    check(std::ranges::any_of(index.at({.x = 0, .y = 3}),
+                  [&](const Entity entity) {
+                      return entity.index == inside.index;
+                  }),
+            "moved entity is re-bucketed");
+}
+
+// The index holds exactly the live Transforms that map onto the grid, each
+// on the tile its position floors to
+static auto index_matches(const Registry& world, const SpatialIndex& index) -> bool {
+    const auto* transforms = world.find_storage<Transform>();
+    const auto  entities   = transforms->dense_entities();
+    size_t      expected   = 0;
+    bool        placed     = true;
+    for (size_t idx = 0; idx < entities.size(); ++idx) {
+        const Entity    entity   = entities[idx];
+        const auto&     position = transforms->dense_components()[idx].position;
+        const TileCoord tile{
+                .x = static_cast<int32_t>(std::floor(position.x / TILE_WIDTH)),
+                .y = static_cast<int32_t>(std::floor(position.y / TILE_HEIGHT))};
+        if (!index.in_bounds(tile)) {
+            placed = placed && !index.contains(entity);
+            continue;
+        }
+        ++expected;
+        placed = placed && std::ranges::any_of(index.at(tile), [&](const Entity other) {
+            return other.index == entity.index &&
+                   other.generation == entity.generation;
+        });
+    }
+    size_t indexed = 0;
+    index.for_each_occupied(
+            [&](const TileCoord /*tile*/, const std::span<const Entity> bucket) {
+                indexed += bucket.size();
+            });
+    return placed && indexed == expected;
+}
+
+static void test_system_incremental() {
+    Registry            world;
+    SpatialIndex        index(6, 6);
+    SpatialIndexSystem  system(index);
+    std::mt19937        rng(126);
+    std::vector<Entity> live;
+
+    const auto random_position = [&] {
+        // Includes positions just off the map on every side
+        return at_pixel(
+                (static_cast<float>(rng() % 80) - 8.0F) * TILE_WIDTH / 10.0F,
+                (static_cast<float>(rng() % 80) - 8.0F) * TILE_HEIGHT / 10.0F);
+    };
+
+    bool in_sync = true;
+    for (int tick = 0; tick < 400; ++tick) {
+        for (int edit = 0; edit < 6; ++edit) {
+            const Entity entity = live.empty() ? Entity{} : live[rng() % live.size()];
+            switch (live.empty() ? 0 : rng() % 5) {
+            case 0: {
+                const Entity created = world.create_entity();
+                world.add_component<Transform>(created, random_position());
+                live.push_back(created);
+                break;
+            }
+            case 1:
+                if (world.has_component<Transform>(entity)) {
+                    world.patch<Transform>(entity) = random_position();
+                }
+                break;
+            case 2:
+                if (world.has_component<Transform>(entity)) {
+                    world.remove_component<Transform>(entity);
+                } else {
+                    world.add_component<Transform>(entity, random_position());
+                }
+                break;
+            case 3:
+                // Removed and re-added before the system sees it
+                world.remove_component<Transform>(entity);
+                world.add_component<Transform>(entity, random_position());
+                break;
+            default:
+                // A create later in the tick may recycle the index
+                world.destroy_entity(entity);
+                std::erase_if(live, [&](const Entity other) {
+                    return other.index == entity.index;
+                });
+                break;
+            }
+        }
+
+        // Some ticks the system runs twice, with writes in between; now and
+        // then it falls further behind than the removal log reaches
+        const bool skipped = tick % 50 >= 40;
+        if (!skipped) {
+            system.update(world);
+            in_sync = in_sync && index_matches(world, index);
+            const Entity late = live.empty() ? Entity{} : live[rng() % live.size()];
+            if (tick % 7 == 0 && world.has_component<Transform>(late)) {
+                world.patch<Transform>(late) = random_position();
+                system.update(world);
+                in_sync = in_sync && index_matches(world, index);
+            }
+        }
+        world.advance_tick();
+    }
+    check(in_sync, "incremental updates keep the index in sync with Transforms");
+}
+
+auto main() -> int {
+    test_queries();
+    test_occupied_list();
+    test_system_tiles();
+    test_system_incremental();
+    return test_result();
+}